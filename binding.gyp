@@ -1,6 +1,10 @@
 {
   'variables':{
     'INTEL_OPENVINO_DIR' : '<!@(node -p \"process.env.INTEL_OPENVINO_DIR\")>',
+    # Build decodeImageInto with libjpeg(-turbo) and libpng, e.g.
+    # `node-gyp rebuild --with_jpeg=true --with_png=true`.
+    'with_jpeg%': 'false',
+    'with_png%': 'false',
   },
   'conditions': [
     ['OS=="linux"', {
@@ -57,6 +61,16 @@
       'libraries' : [
         '-linference_engine',
         '-linference_engine_legacy'
+      ],
+      'conditions': [
+        ['with_jpeg=="true"', {
+          'defines': [ 'IE_NODE_WITH_JPEG' ],
+          'libraries': [ '-ljpeg' ]
+        }],
+        ['with_png=="true"', {
+          'defines': [ 'IE_NODE_WITH_PNG' ],
+          'libraries': [ '-lpng' ]
+        }]
       ]
     }
   ]
@@ -19,33 +19,21 @@ function showResults(results, labels) {
   })
 }
 
-function topSSDResults(tensor, threshold = 0.5, dims) {
+// Boxes are normalized unless |transform|, from fillFromImage, is given, in
+// which case they are mapped to source image pixels. |output| is the
+// DetectionOutput Blob, which is decoded natively with class-wise NMS; only
+// the kept boxes become ObjectDetectionPredictions.
+function topSSDResults(output, threshold = 0.5, transform) {
+  const options = {threshold: threshold, nms: true};
+  if (transform) {
+    options.transform = transform;
+  }
+  const rows = postProcessing.decodeSSD(output, options);
   const result = [];
-  const classIdIndex = 1;
-  const predictionIndex = 2;
-  const x1Index = 3;
-  const y1Index = 4;
-  const x2Index = 5;
-  const y2Index = 6;
-  const dataBoxLength = dims[dims.length - 1];
-
-  for (let b = 0; b < dims[0]; b++) {
-    const batchOffset = b * dims[2];
-    for (let i = 0; i < dims[2]; i++) {
-      const curProposal = batchOffset + dataBoxLength * i;
-
-      const prediction = tensor[curProposal + predictionIndex];
-
-      if (prediction && prediction >= threshold) {
-        const classId = tensor[curProposal + classIdIndex];
-        const x1 = tensor[curProposal + x1Index];
-        const y1 = tensor[curProposal + y1Index];
-        const x2 = tensor[curProposal + x2Index];
-        const y2 = tensor[curProposal + y2Index];
-        result.push(new postProcessing.ObjectDetectionPrediction(
-            x1, y1, x2, y2, prediction, classId));
-      }
-    }
+  for (let i = 0; i < rows.length; i += 7) {
+    result.push(new postProcessing.ObjectDetectionPrediction(
+        rows[i + 3], rows[i + 4], rows[i + 5], rows[i + 6], rows[i + 2],
+        rows[i + 1]));
   }
   return result;
 }
@@ -16,6 +16,7 @@ var output_info;
 var progress = false;
 var preOptions;
 var postOptions;
+var colorFormat;
 
 let front = false;
 let stats = new Stats();
@@ -23,39 +24,13 @@ let streaming = false;
 let track;
 
 function topResults(tensor, labels, k) {
-  let temp = Array.from(tensor);
-  let softmax = postOptions.softmax || false;
-  let probs;
-
-  if (softmax) {
-    let sum = temp.map(y => Math.exp(y)).reduce((a, b) => {return a + b})
-    probs = temp.map((prob) => {
-      return Math.exp(prob) / sum;
-    });
-  } else {
-    probs = temp;
-  }
-
-  let indexes = probs.map((prob, index) => [prob, index]);
-  let sorted = indexes.sort((a, b) => {
-    if (a[0] === b[0]) {
-      return 0;
-    }
-    return a[0] < b[0] ? -1 : 1;
-  });
-  sorted.reverse();
-  let classes = [];
-  for (let i = 0; i < k; ++i) {
-    const prob = sorted[i][0];
-    const index = sorted[i][1];
-    const c = {
-      id: index.toString(),
-      label: labels ? labels[index] : '',
-      prob: prob.toFixed(6)
-    };
-    classes.push(c);
-  }
-  return classes;
+  const top =
+      ie.postProcessing.topK(tensor, k, {softmax: postOptions.softmax});
+  return Array.from(top.indices, (index, i) => ({
+    id: index.toString(),
+    label: labels ? labels[index] : '',
+    prob: top.scores[i].toFixed(6)
+  }));
 }
 
 function showResults(results, time) {
@@ -83,54 +58,33 @@ function showResults(results, time) {
 }
 
 /**
- * Prepare Input Info before infer
+ * Draw the image on the canvas and return its RGBA pixels
  */
-async function prepareInputInfo(image, input_data, width, height) {
+function getImagePixels(image, width, height) {
   canvasContext.drawImage(
       image, 0, 0, canvasElement.width, canvasElement.height);
   if (canvasElement.width !== width || canvasElement.height !== height) {
     throw new Error(`canvas.width(${canvasElement.width}) is not ${
         width} or canvas.height(${canvasElement.height}) is not ${height}`);
   }
+  return canvasContext.getImageData(0, 0, width, height).data;
+}
 
-  let context = canvasElement.getContext('2d');
-  let pixels = context.getImageData(0, 0, width, height).data;
-
-  let channels = 3;
-  const mean = preOptions.mean || [0, 0, 0, 0];
-  const std = preOptions.std || [1, 1, 1, 1];
-  const channelScheme = preOptions.channelScheme || 'RGB';
-  const norm = preOptions.norm || false;
-  const imageChannels = 4;
-
-  if (norm) {
-    pixels = new Float32Array(pixels).map(p => p / 255);
-  }
-
-  if (channelScheme === 'RGB') {
-    for (let y = 0; y < height; ++y) {
-      for (let x = 0; x < width; ++x) {
-        for (let c = 0; c < channels; ++c) {
-          let value = pixels[y * width * imageChannels + x * imageChannels + c];
-          input_data[y * width * channels + x * channels + c] =
-              (value - mean[c]) / std[c];
-        }
-      }
-    }
-  } else if (channelScheme === 'BGR') {
-    for (let y = 0; y < height; ++y) {
-      for (let x = 0; x < width; ++x) {
-        for (let c = 0; c < channels; ++c) {
-          let value =
-              pixels[y * width * imageChannels + x * imageChannels + (channels - c - 1)];
-          input_data[y * width * channels + x * channels + c] =
-              (value - mean[c]) / std[c];
-        }
-      }
-    }
+/**
+ * Let the plugin subtract the mean and divide by the std of every frame
+ */
+function setMeanAndScale(input_info) {
+  const mean = preOptions.mean || [0, 0, 0];
+  const std = preOptions.std || [1, 1, 1];
+  // Normalized models expect pixels in [0, 1].
+  const range = preOptions.norm ? 255 : 1;
+  const pre_process = input_info.getPreProcess();
+  pre_process.init(3);
+  for (let c = 0; c < 3; ++c) {
+    pre_process.getPreProcessChannel(c).meanValue = mean[c] * range;
+    pre_process.getPreProcessChannel(c).stdScale = std[c] * range;
   }
-
-  return;
+  pre_process.setVariant('mean_value');
 }
 
 
@@ -147,13 +101,11 @@ async function predict(imageSource) {
   }
 
   let infer_req = exec_net.createInferRequest();
-  const input_blob = infer_req.getBlob(input_info.name());
-  const input_data = new Float32Array(input_blob.wmap());
-
-  prepareInputInfo(
-      imageSource, input_data, input_info.getDims()[2],
-      input_info.getDims()[3]);
-  input_blob.unmap();
+  const pixels = getImagePixels(
+      imageSource, input_info.getDims()[2], input_info.getDims()[3]);
+  // The ImageData is used in place; the plugin drops the alpha channel and
+  // orders the channels for the model.
+  infer_req.setBlob(input_info.name(), pixels, {colorFormat: colorFormat});
 
   let startTime = performance.now();
   await infer_req.startAsync();
@@ -245,6 +197,12 @@ async function loadModel(model) {
 
   input_info = inputs_info[0];
   input_info.setLayout('nhwc');
+  input_info.setPrecision('u8');
+  setMeanAndScale(input_info);
+  // The plugin converts frames to BGR, so RGB models get RGBA pixels
+  // described as BGRX.
+  const channelScheme = preOptions.channelScheme || 'RGB';
+  colorFormat = channelScheme === 'RGB' ? 'bgrx' : 'rgbx';
   output_info = outputs_info[0];
 
   try {
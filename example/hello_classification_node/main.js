@@ -206,18 +206,6 @@ async function main() {
   console.log(`Set input layout to 'nhwc'.`);
   input_info.setLayout('nhwc');
 
-  const rgb = color === 'bgr' ? {r: 2, g: 1, b: 0} : {r: 0, g: 1, b: 2};
-  const preProcessInfo = input_info.getPreProcess();
-  preProcessInfo.init(3);
-  preProcessInfo.getPreProcessChannel(rgb.r).stdScale = std[rgb.r];
-  preProcessInfo.getPreProcessChannel(rgb.g).stdScale = std[rgb.g];
-  preProcessInfo.getPreProcessChannel(rgb.b).stdScale = std[rgb.b];
-
-  preProcessInfo.getPreProcessChannel(rgb.r).meanValue = mean[rgb.r];
-  preProcessInfo.getPreProcessChannel(rgb.g).meanValue = mean[rgb.g];
-  preProcessInfo.getPreProcessChannel(rgb.b).meanValue = mean[rgb.b];
-  preProcessInfo.setVariant('mean_value');
-
   const output_info = outputs_info[0];
   showBreakLine();
 
@@ -245,34 +233,26 @@ async function main() {
   highlight(`Succeeded: load network took ${load_network_time.toFixed(2)} ms.`);
   showBreakLine();
 
-  let infer_req;
   let infer_time = [];
 
+  const infer_req = exec_net.createInferRequest();
+  // Convert the RGBA bitmap and apply mean and std in one native pass.
+  infer_req.getBlob(input_info.name())
+      .fillFromImage(
+          image.bitmap.data, image.bitmap.width, image.bitmap.height,
+          {channelOrder: color, mean: mean, std: std});
+  const output_data = new Float32Array(output_info.getDims().reduce(
+      (acc, dim) => acc * dim, 1));
+
   console.log(`Start to infer ${sync ? '' : 'a'}synchronously for ${
       iterations} iterations.`);
 
   for (let i = 0; i < iterations; i++) {
-    start_time = performance.now();
-    infer_req = exec_net.createInferRequest();
-
-    const input_blob = infer_req.getBlob(input_info.name());
-    const input_data = new Float32Array(input_blob.wmap());
-
-    image.scan(
-        0, 0, image.bitmap.width, image.bitmap.height, function(x, y, idx) {
-          // Convert from RGBA to BGR (IE default)
-          let i = Math.floor(idx / 4) * 3;
-          input_data[i + rgb.r] = image.bitmap.data[idx + 0];  // R
-          input_data[i + rgb.g] = image.bitmap.data[idx + 1];  // G
-          input_data[i + rgb.b] = image.bitmap.data[idx + 2];  // B
-        });
-    input_blob.unmap();
-
     start_time = performance.now();
     if (sync) {
       infer_req.infer();
     } else {
-      await infer_req.startAsync();
+      await infer_req.run({}, {[output_info.name()]: output_data});
     }
     infer_time.push(performance.now() - start_time);
   }
@@ -292,11 +272,18 @@ async function main() {
   } catch (error) {
     warning(error);
   }
-  const output_blob = infer_req.getBlob(output_info.name());
-  const output_data = new Float32Array(output_blob.rmap());
-  const results =
-      postProcessing.topClassificationResults(output_data, labels, top_k);
-  output_blob.unmap();
+  if (sync) {
+    const output_blob = infer_req.getBlob(output_info.name());
+    output_data.set(new Float32Array(output_blob.rmap()));
+    output_blob.unmap();
+  }
+  // Selects the top k natively instead of sorting all of the scores.
+  const top = postProcessing.topK(output_data, top_k);
+  const results = Array.from(top.indices, (index, i) => ({
+    id: index.toString(),
+    label: labels ? labels[index] : '',
+    prob: top.scores[i].toFixed(6)
+  }));
   console.log(`The top ${top_k} results:`);
   classification.showResults(results);
   showBreakLine();
@@ -60,6 +60,13 @@ const option_definitions = [
     description:
         'Optional. The minimal probability of the visibility object. Default value is 0.5'
   },
+  {
+    name: 'letterbox',
+    type: Boolean,
+    defaultValue: false,
+    description: 'Optional. Resize the image with its aspect ratio ' +
+        'preserved and report boxes in image pixels. Default value is false.'
+  },
   {
     name: 'sync',
     alias: 's',
@@ -102,6 +109,7 @@ async function main() {
   const iterations = options.iterations;
   const threshold = options.threshold;
   const sync = options.sync;
+  const letterbox = options.letterbox;
 
   if (iterations <= 0) {
     warning('The number of iterations should be greater than 0.');
@@ -144,12 +152,22 @@ async function main() {
   const input_dims = input_info.getDims();
   const input_height = input_dims[2];
   const input_width = input_dims[3];
-  if (image.bitmap.height !== input_height &&
+  if (image.bitmap.height !== input_height ||
       image.bitmap.width !== input_width) {
-    console.log(`Resize image from (${image.bitmap.height}, ${
+    console.log(`Resize the image from (${image.bitmap.height}, ${
         image.bitmap.width}) to (${input_height}, ${input_width}).`);
-    image.resize(input_width, input_height, jimp.RESIZE_BILINEAR);
   }
+  // The RGBA bitmap is used as is; the plugin drops the alpha channel,
+  // converts to BGR and resizes as part of the request.
+  const image_options = {
+    tensorDesc: {
+      precision: 'u8',
+      layout: 'nhwc',
+      dims: [1, 4, image.bitmap.height, image.bitmap.width]
+    },
+    resizeAlgorithm: 'resize_bilinear',
+    colorFormat: 'rgbx'
+  };
   showBreakLine();
   console.log(`Check ${device_name} plugin version:`);
   showPluginVersions(core.getVersions(device_name));
@@ -160,23 +178,21 @@ async function main() {
   highlight(`Succeeded: load network took ${load_network_time.toFixed(2)} ms.`);
   showBreakLine();
   let infer_req;
+  let transform;
   let infer_time = [];
   console.log(`Start to infer ${sync ? '' : 'a'}synchronously for ${
       iterations} iterations.`);
   for (let i = 0; i < iterations; i++) {
     start_time = performance.now();
     infer_req = exec_net.createInferRequest();
-    const input_blob = infer_req.getBlob(input_info.name());
-    const input_data = new Uint8Array(input_blob.wmap());
-    image.scan(
-        0, 0, image.bitmap.width, image.bitmap.height, function(x, y, idx) {
-          // Convert from RGBA to BGR (IE default)
-          let i = Math.floor(idx / 4) * 3;
-          input_data[i + 2] = image.bitmap.data[idx + 0];  // R
-          input_data[i + 1] = image.bitmap.data[idx + 1];  // G
-          input_data[i + 0] = image.bitmap.data[idx + 2];  // B
-        });
-    input_blob.unmap();
+    if (letterbox) {
+      transform = infer_req.getBlob(input_info.name())
+                      .fillFromImage(
+                          image.bitmap.data, image.bitmap.width,
+                          image.bitmap.height, {resize: 'letterbox'});
+    } else {
+      infer_req.setBlob(input_info.name(), image.bitmap.data, image_options);
+    }
     start_time = performance.now();
     if (sync) {
       infer_req.infer();
@@ -198,11 +214,8 @@ async function main() {
   } catch (error) {
     warning(error);
   }
-  const output_blob = infer_req.getBlob(output_info.name());
-  const output_data = new Float32Array(output_blob.rmap());
   const results = objectDetection.topSSDResults(
-      output_data, threshold, output_info.getDims());
-  output_blob.unmap();
+      infer_req.getBlob(output_info.name()), threshold, transform);
   console.log(`Found ${results.length} objects:`);
   objectDetection.showResults(results, labels);
   showBreakLine();
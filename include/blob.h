@@ -2,7 +2,10 @@
 #define IE_BLOB_H
 
 #include <napi.h>
+#include <memory>
+#include <vector>
 
+#include "blob_arena.h"
 #include "inference_engine.hpp"
 
 namespace ienodejs {
@@ -10,15 +13,29 @@ namespace ienodejs {
 class Blob : public Napi::ObjectWrap<Blob> {
  public:
   static void Init(const Napi::Env& env);
-  static Napi::Value NewInstance(const Napi::Env& env,
-                                 const InferenceEngine::Blob::Ptr& actual);
+  // A Blob of a |lease| keeps it out of the arena until it is released. The
+  // memory of |actual| is reported by the infer request it belongs to.
+  static Napi::Value NewInstance(
+      const Napi::Env& env,
+      const InferenceEngine::Blob::Ptr& actual,
+      const std::shared_ptr<BlobArena::BlobSet>& lease);
+  // decodeImageInto(blob, images, options), exported by the module.
+  static Napi::Value DecodeImageInto(const Napi::CallbackInfo& info);
+  // Sets |actual| if |value| is a Blob, for APIs that also take other
+  // values. Throws and returns false if the Blob has been disposed.
+  static bool GetActual(const Napi::Env& env,
+                        const Napi::Value& value,
+                        InferenceEngine::Blob::Ptr* actual);
   explicit Blob(const Napi::CallbackInfo& info);
 
  private:
+  friend class InferRequest;
+
   static Napi::FunctionReference constructor;
   // APIs
   Napi::Value ByteSize(const Napi::CallbackInfo& info);
   Napi::Value Size(const Napi::CallbackInfo& info);
+  Napi::Value GetTensorDesc(const Napi::CallbackInfo& info);
   Napi::Value Rwmap(const Napi::CallbackInfo& info) {
     return Memmap(info, READ_WRITE);
   }
@@ -29,14 +46,26 @@ class Blob : public Napi::ObjectWrap<Blob> {
     return Memmap(info, WRITE);
   }
   Napi::Value Unmap(const Napi::CallbackInfo& info);
+  Napi::Value FillFromImage(const Napi::CallbackInfo& info);
+  void Dispose(const Napi::CallbackInfo& info);
 
   // Helpers
+  // Detaches the ArrayBuffers returned by rmap, wmap and rwmap and drops the
+  // blob and its lease, e.g. once the lease goes back to the arena.
+  void Release();
   const static int READ = 0;
   const static int WRITE = 1;
   const static int READ_WRITE = 2;
   Napi::Value Memmap(const Napi::CallbackInfo& info, const int mode);
+  // Throws and returns true if the Blob has been disposed.
+  bool CheckDisposed(const Napi::Env& env);
 
   InferenceEngine::Blob::Ptr actual_;
+  bool disposed_ = false;
+  std::shared_ptr<BlobArena::BlobSet> lease_;
+  // The ArrayBuffers over the blob's memory, which are detached when it is
+  // released so that they cannot write into memory lent to another request.
+  std::vector<Napi::Reference<Napi::ArrayBuffer>> mapped_buffers_;
   std::unique_ptr<InferenceEngine::LockedMemory<void>> locked_memory_;
 };
 
@@ -0,0 +1,70 @@
+#ifndef IE_NODE_BLOB_ARENA_H
+#define IE_NODE_BLOB_ARENA_H
+
+#include <napi.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "inference_engine.hpp"
+
+namespace ienodejs {
+
+// A bounded pool of input/output blob sets shared by the InferRequests of one
+// ExecutableNetwork. A request leases a set through SetBlob and the set goes
+// back to the pool once the last reference to the lease is dropped. The sets
+// are reported to V8 through AdjustExternalMemory.
+class BlobArena : public std::enable_shared_from_this<BlobArena> {
+ public:
+  using BlobSet = std::map<std::string, InferenceEngine::Blob::Ptr>;
+
+  struct Stats {
+    size_t capacity;
+    size_t allocated;
+    size_t in_use;
+    size_t peak_in_use;
+    double average_in_use;
+    uint64_t leases;
+    uint64_t exhausted;
+    size_t set_byte_size;
+  };
+
+  BlobArena(const Napi::Env& env,
+            const InferenceEngine::ExecutableNetwork& network,
+            size_t capacity);
+  ~BlobArena();
+
+  // Returns nullptr when all |capacity| sets are leased.
+  std::shared_ptr<BlobSet> Acquire();
+  // The blobs of the first set, which requests bind while they hold no lease
+  // so that the blobs the plugin allocated for them are freed. A request
+  // never reads or writes them without a lease.
+  const BlobSet& GetIdleSet() const { return idle_set_; }
+  Stats GetStats();
+
+ private:
+  std::unique_ptr<BlobSet> Allocate();
+  void Recycle(BlobSet* set);
+  void Sample();
+
+  Napi::Env env_;
+  std::map<std::string, InferenceEngine::TensorDesc> descs_;
+  BlobSet idle_set_;
+  std::vector<std::unique_ptr<BlobSet>> free_sets_;
+  std::mutex mutex_;
+  size_t capacity_;
+  size_t allocated_;
+  size_t in_use_;
+  size_t peak_in_use_;
+  uint64_t leases_;
+  uint64_t exhausted_;
+  uint64_t samples_;
+  double in_use_sum_;
+  size_t set_byte_size_;
+};
+
+}  // namespace ienodejs
+
+#endif  // IE_NODE_BLOB_ARENA_H
@@ -0,0 +1,74 @@
+#ifndef IE_NODE_CASCADE_H
+#define IE_NODE_CASCADE_H
+
+#include <napi.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "detection_utils.h"
+#include "image_utils.h"
+#include "inference_engine.hpp"
+
+namespace ienodejs {
+
+// Runs a detector on a frame, crops the detected boxes out of the frame and
+// classifies the crops in batches with a second network, all on a worker
+// thread.
+class Cascade : public Napi::ObjectWrap<Cascade> {
+ public:
+  static void Init(const Napi::Env& env, Napi::Object exports);
+  explicit Cascade(const Napi::CallbackInfo& info);
+  ~Cascade();
+
+ private:
+  friend class CascadeAsyncWorker;
+
+  // A detector and a classifier request that run one frame at a time.
+  struct Requests {
+    InferenceEngine::InferRequest detector;
+    InferenceEngine::InferRequest classifier;
+  };
+
+  // The settings that a run reads on the worker thread.
+  struct Config {
+    std::string detector_input;
+    std::string detector_output;
+    std::string classifier_input;
+    std::string classifier_output;
+    // The inputs without data; each run points them at the input blobs.
+    image::Tensor detector_tensor;
+    image::Tensor classifier_tensor;
+    float threshold = 0.5f;
+    bool nms = false;
+    detection::NmsOptions nms_options;
+    // Only boxes of these labels are classified, all of them if empty.
+    std::vector<float> labels;
+    // Each crop is enlarged by this fraction of the box on every side.
+    float padding = 0.0f;
+    uint32_t top_k = 1;
+    bool softmax = false;
+  };
+
+  static Napi::FunctionReference constructor;
+  // APIs
+  Napi::Value Run(const Napi::CallbackInfo& info);
+
+  // Helpers
+  // Takes an idle pair of requests, or creates one.
+  Requests AcquireRequests();
+  void ReleaseRequests(const Requests& requests);
+
+  InferenceEngine::ExecutableNetwork detector_;
+  InferenceEngine::ExecutableNetwork classifier_;
+  Config config_;
+  std::vector<Requests> idle_requests_;
+  // The input and output bytes of one pair of requests.
+  int64_t requests_byte_size_ = 0;
+  // Native bytes reported to V8 through AdjustExternalMemory.
+  int64_t external_memory_ = 0;
+};
+
+}  // namespace ienodejs
+
+#endif  // IE_NODE_CASCADE_H
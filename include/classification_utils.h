@@ -0,0 +1,26 @@
+#ifndef IE_NODE_CLASSIFICATION_UTILS_H
+#define IE_NODE_CLASSIFICATION_UTILS_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ienodejs {
+
+namespace classification {
+
+// Writes the indices and scores of the |k| largest of |count| scores to
+// |indices| and |values| by descending score, ties by ascending index. With
+// |softmax| the written scores are the softmax of the raw ones, computed
+// over all |count| of them. |k| should not exceed |count|.
+void TopK(const float* scores,
+          size_t count,
+          size_t k,
+          bool softmax,
+          int32_t* indices,
+          float* values);
+
+}  // namespace classification
+
+}  // namespace ienodejs
+
+#endif  // IE_NODE_CLASSIFICATION_UTILS_H
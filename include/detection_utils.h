@@ -0,0 +1,97 @@
+#ifndef IE_NODE_DETECTION_UTILS_H
+#define IE_NODE_DETECTION_UTILS_H
+
+#include <cstddef>
+#include <vector>
+
+namespace ienodejs {
+
+namespace detection {
+
+// One box in the 7-value layout of the DetectionOutput layer:
+// [image_id, label, confidence, x1, y1, x2, y2].
+struct Detection {
+  float image_id;
+  float label;
+  float confidence;
+  float x1;
+  float y1;
+  float x2;
+  float y2;
+};
+
+const size_t kDetectionSize = 7;
+
+enum class OverlapMetric {
+  // Intersection over union.
+  IOU,
+  // Intersection over the area of the smaller box, which also matches the
+  // part of an object that a tile border cut off with the whole object.
+  IOS,
+};
+
+struct NmsOptions {
+  float threshold = 0.5f;
+  OverlapMetric metric = OverlapMetric::IOU;
+  // Boxes of different labels never suppress each other unless set.
+  bool class_agnostic = false;
+  // Zero keeps every box that survives.
+  size_t max_detections = 0;
+};
+
+float GetOverlap(const Detection& a, const Detection& b, OverlapMetric metric);
+
+// Greedy non-maximum suppression. Returns the kept boxes by descending
+// confidence.
+std::vector<Detection> NonMaxSuppression(std::vector<Detection> detections,
+                                         const NmsOptions& options);
+
+// Reads the boxes of at least |threshold| confidence from the |count| rows of
+// a DetectionOutput tensor, up to the row with a negative image id that ends
+// the valid ones. With |nms| the boxes of each image are suppressed as set by
+// |options|; its max_detections limits the boxes of each image either way.
+// Returns the boxes by ascending image id, then by descending confidence.
+// Throws std::range_error for an image id that is NaN or not below |count|.
+std::vector<Detection> DecodeDetectionOutput(const float* rows,
+                                             size_t count,
+                                             float threshold,
+                                             bool nms,
+                                             const NmsOptions& options);
+
+// One [N, C, H, W] output of a RegionYolo layer. Each of the C / (coords + 1
+// + classes) anchors of the scale has coords box planes, an objectness plane
+// and a plane per class.
+struct YoloScale {
+  const float* data;
+  size_t batch;
+  size_t channels;
+  size_t height;
+  size_t width;
+  // The width and height of each anchor of the scale, in input pixels.
+  std::vector<float> anchors;
+};
+
+struct YoloOptions {
+  size_t classes = 80;
+  size_t coords = 4;
+  float input_width = 416.0f;
+  float input_height = 416.0f;
+  float threshold = 0.5f;
+  // Set for raw convolution outputs; RegionYolo already applies the logistic
+  // function to the coordinates, the objectness and the classes.
+  bool sigmoid = false;
+};
+
+// Decodes the boxes of every scale whose objectness times class probability
+// is at least the threshold, in fractions of the input size, and suppresses
+// them per image as DecodeDetectionOutput does. Labels are class indices.
+std::vector<Detection> DecodeYolo(const std::vector<YoloScale>& scales,
+                                  const YoloOptions& options,
+                                  bool nms,
+                                  const NmsOptions& nms_options);
+
+}  // namespace detection
+
+}  // namespace ienodejs
+
+#endif  // IE_NODE_DETECTION_UTILS_H
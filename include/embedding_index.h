@@ -0,0 +1,44 @@
+#ifndef IE_NODE_EMBEDDING_INDEX_H
+#define IE_NODE_EMBEDDING_INDEX_H
+
+#include <napi.h>
+#include <cstdint>
+#include <memory>
+
+#include "embedding_utils.h"
+
+namespace ienodejs {
+
+// A gallery of embeddings, such as the outputs of re-identification
+// models, with top-k search by cosine similarity or inner product.
+class EmbeddingIndex : public Napi::ObjectWrap<EmbeddingIndex> {
+ public:
+  static void Init(const Napi::Env& env, Napi::Object exports);
+  explicit EmbeddingIndex(const Napi::CallbackInfo& info);
+  ~EmbeddingIndex();
+
+ private:
+  static Napi::FunctionReference constructor;
+  // APIs
+  void Add(const Napi::CallbackInfo& info);
+  Napi::Value Remove(const Napi::CallbackInfo& info);
+  Napi::Value Search(const Napi::CallbackInfo& info);
+  void Clear(const Napi::CallbackInfo& info);
+  Napi::Value GetSize(const Napi::CallbackInfo& info);
+  Napi::Value GetDimension(const Napi::CallbackInfo& info);
+
+  // Helpers
+  // Returns the gallery to change, copied first if a running search holds it.
+  embedding::VectorIndex* MutableIndex();
+  // Reports the change of the size of the gallery to V8.
+  void UpdateExternalMemory(const Napi::Env& env);
+
+  // Shared with the searches that are running.
+  std::shared_ptr<embedding::VectorIndex> index_;
+  uint32_t threads_ = 1;
+  int64_t external_memory_ = 0;
+};
+
+}  // namespace ienodejs
+
+#endif  // IE_NODE_EMBEDDING_INDEX_H
@@ -0,0 +1,74 @@
+#ifndef IE_NODE_EMBEDDING_UTILS_H
+#define IE_NODE_EMBEDDING_UTILS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace ienodejs {
+
+namespace embedding {
+
+// A brute-force index of embeddings of one dimension, searched by inner
+// product. The vectors are kept contiguous, as floats or as int8 with a
+// scale per vector.
+class VectorIndex {
+ public:
+  // With |normalize| the vectors and queries are scaled to unit length, so
+  // the scores are cosine similarities.
+  VectorIndex(size_t dimension, bool normalize, bool quantize);
+
+  // Adds the vector of |id|, or replaces it.
+  void Add(uint32_t id, const float* vector);
+  // Returns false if |id| is not in the index.
+  bool Remove(uint32_t id);
+  void Clear();
+
+  // Writes the ids and scores of the best min(|k|, size()) entries for each
+  // of the |count| rows of |queries|, by descending score, to consecutive
+  // rows of |ids| and |scores|. The queries and chunks of the gallery are
+  // scored on up to |threads| threads of the shared pool. Returns how many
+  // were written per query.
+  size_t Search(const float* queries,
+                size_t count,
+                size_t k,
+                size_t threads,
+                uint32_t* ids,
+                float* scores) const;
+
+  size_t size() const { return ids_.size(); }
+  size_t dimension() const { return dimension_; }
+  bool normalize() const { return normalize_; }
+  bool quantize() const { return quantize_; }
+  // The bytes of the stored vectors.
+  size_t byte_size() const;
+
+ private:
+  // Writes the scores of the entries in [begin, end) to the first
+  // end - begin items of |scores|.
+  void Score(const float* query,
+             const int8_t* quantized_query,
+             float query_scale,
+             size_t begin,
+             size_t end,
+             float* scores) const;
+  // Writes |vector|, normalized if needed, to |output|.
+  void Prepare(const float* vector, float* output) const;
+
+  size_t dimension_;
+  bool normalize_;
+  bool quantize_;
+  std::vector<float> vectors_;
+  std::vector<int8_t> quantized_;
+  std::vector<float> scales_;
+  // The id of each slot and the slot of each id.
+  std::vector<uint32_t> ids_;
+  std::unordered_map<uint32_t, size_t> slots_;
+};
+
+}  // namespace embedding
+
+}  // namespace ienodejs
+
+#endif  // IE_NODE_EMBEDDING_UTILS_H
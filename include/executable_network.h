@@ -2,7 +2,9 @@
 #define IE_EXECUTABLE_NETWORK_H
 
 #include <napi.h>
+#include <memory>
 
+#include "blob_arena.h"
 #include "inference_engine.hpp"
 
 namespace ienodejs {
@@ -16,15 +18,28 @@ class ExecutableNetwork : public Napi::ObjectWrap<ExecutableNetwork> {
                                const InferenceEngine::Core& core,
                                Napi::Promise::Deferred& deferred);
   explicit ExecutableNetwork(const Napi::CallbackInfo& info);
+  ~ExecutableNetwork();
 
  private:
+  friend class Cascade;
   friend class LoadNetworkAsyncWorker;
 
   static Napi::FunctionReference constructor;
   // APIs
   Napi::Value CreateInferRequest(const Napi::CallbackInfo& info);
+  void EnableBlobArena(const Napi::CallbackInfo& info);
+  Napi::Value GetBlobArenaStats(const Napi::CallbackInfo& info);
+  void Dispose(const Napi::CallbackInfo& info);
+
+  // Helpers
+  // Throws and returns true if dispose() has been called.
+  bool CheckDisposed(const Napi::Env& env);
 
   InferenceEngine::ExecutableNetwork actual_;
+  std::shared_ptr<BlobArena> arena_;
+  bool disposed_ = false;
+  // Native bytes reported to V8 through AdjustExternalMemory.
+  int64_t external_memory_ = 0;
 };
 
 }  // namespace ienodejs
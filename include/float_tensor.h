@@ -0,0 +1,41 @@
+#ifndef IE_NODE_FLOAT_TENSOR_H
+#define IE_NODE_FLOAT_TENSOR_H
+
+#include <napi.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "inference_engine.hpp"
+
+namespace ienodejs {
+
+// The FP32 data of a Blob, Float32Array or {data, dims} argument and its
+// dims, read in place. A Float32Array has dims [1, length]. FP16 blobs are
+// converted. A Blob stays mapped while this lives.
+class FloatTensor {
+ public:
+  // Reads |blob| if set, otherwise |value|. Returns an error message if
+  // neither can be read.
+  std::string Init(const Napi::Value& value,
+                   const InferenceEngine::Blob::Ptr& blob);
+
+  const float* data() const { return data_; }
+  const InferenceEngine::SizeVector& dims() const { return dims_; }
+  size_t size() const;
+
+ private:
+  std::string Map(const InferenceEngine::Blob::Ptr& blob);
+  // Reads a {data: Float32Array, dims} object.
+  std::string Read(const Napi::Object& object);
+
+  InferenceEngine::MemoryBlob::Ptr blob_;
+  std::unique_ptr<InferenceEngine::LockedMemory<const void>> memory_;
+  std::vector<float> converted_;
+  const float* data_ = nullptr;
+  InferenceEngine::SizeVector dims_;
+};
+
+}  // namespace ienodejs
+
+#endif  // IE_NODE_FLOAT_TENSOR_H
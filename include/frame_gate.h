@@ -0,0 +1,49 @@
+#ifndef IE_NODE_FRAME_GATE_H
+#define IE_NODE_FRAME_GATE_H
+
+#include <napi.h>
+#include <cstdint>
+#include <vector>
+
+namespace ienodejs {
+
+// Decides whether a video frame differs enough from the last inferred one to
+// be worth another inference, by comparing coarse luma grids of the two.
+class FrameGate : public Napi::ObjectWrap<FrameGate> {
+ public:
+  static void Init(const Napi::Env& env, Napi::Object exports);
+  explicit FrameGate(const Napi::CallbackInfo& info);
+
+ private:
+  static Napi::FunctionReference constructor;
+  // APIs
+  Napi::Value Check(const Napi::CallbackInfo& info);
+  Napi::Value GetStats(const Napi::CallbackInfo& info);
+  void Reset(const Napi::CallbackInfo& info);
+  Napi::Value GetThreshold(const Napi::CallbackInfo& info);
+  void SetThreshold(const Napi::CallbackInfo& info, const Napi::Value& value);
+
+  // Options
+  float threshold_ = 0.02f;
+  size_t grid_size_ = 32;
+  // Forces an inference after this many consecutive skips, if not zero.
+  uint32_t max_skips_ = 0;
+  // Compares the largest cell difference instead of the mean one, which
+  // catches motion in a small part of the frame.
+  bool use_max_ = false;
+
+  // The luma grid of the last inferred frame and the frame size it was
+  // computed from. Empty until the first frame.
+  std::vector<float> reference_;
+  size_t width_ = 0;
+  size_t height_ = 0;
+
+  uint64_t frames_ = 0;
+  uint64_t skipped_ = 0;
+  uint32_t consecutive_skips_ = 0;
+  double last_difference_ = 0.0;
+};
+
+}  // namespace ienodejs
+
+#endif  // IE_NODE_FRAME_GATE_H
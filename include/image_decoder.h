@@ -0,0 +1,43 @@
+#ifndef IE_NODE_IMAGE_DECODER_H
+#define IE_NODE_IMAGE_DECODER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ienodejs {
+
+namespace image {
+
+// Packed 8-bit RGB pixels of a decoded image.
+struct DecodedImage {
+  std::vector<uint8_t> pixels;
+  size_t width = 0;
+  size_t height = 0;
+  // The size stored in the file, before any DCT scaling.
+  size_t source_width = 0;
+  size_t source_height = 0;
+};
+
+// The largest image that is decoded, checked against the size in the header
+// before any pixel is allocated. 8K frames have about 33M pixels.
+const size_t kMaxImagePixels = 64 * 1024 * 1024;
+
+bool IsJPEG(const uint8_t* data, size_t size);
+bool IsPNG(const uint8_t* data, size_t size);
+
+// Decodes a JPEG or PNG, throwing std::range_error if it has more than
+// kMaxImagePixels pixels, and std::runtime_error on other failures or if the
+// decoder was not built in. JPEGs are downscaled while decoding, by DCT
+// scaling, to the smallest size still covering |min_width| x |min_height|.
+void DecodeImage(const uint8_t* data,
+                 size_t size,
+                 size_t min_width,
+                 size_t min_height,
+                 DecodedImage* image);
+
+}  // namespace image
+
+}  // namespace ienodejs
+
+#endif  // IE_NODE_IMAGE_DECODER_H
@@ -0,0 +1,89 @@
+#ifndef IE_NODE_IMAGE_UTILS_H
+#define IE_NODE_IMAGE_UTILS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ienodejs {
+
+namespace image {
+
+enum class PixelFormat { RGBA, BGRA, RGB, BGR };
+enum class ElementType { U8, FP16, FP32 };
+
+bool IsPixelFormatName(const std::string& name);
+PixelFormat GetPixelFormatByName(const std::string& name);
+size_t GetBytesPerPixel(const PixelFormat& format);
+
+// An 8-bit frame, e.g. the data of an ImageData or a decoded image. |stride|
+// is the distance in bytes between rows, so a frame can be a region of a
+// larger one.
+struct Frame {
+  const uint8_t* data;
+  size_t width;
+  size_t height;
+  size_t stride;
+  PixelFormat format;
+};
+
+struct Rect {
+  size_t x;
+  size_t y;
+  size_t width;
+  size_t height;
+};
+
+// A three-channel image of one batch item, planar (CHW) or interleaved (HWC).
+struct Tensor {
+  void* data;
+  ElementType type;
+  size_t width;
+  size_t height;
+  bool planar;
+  bool bgr;
+  // Each destination channel is written as (pixel - mean) / std.
+  float mean[3];
+  float std[3];
+  // The frame is resized into |target|. The pixels around it are set to
+  // |pad| before normalization.
+  Rect target;
+  float pad;
+};
+
+// Maps tensor coordinates back to frame coordinates:
+// frame_x = (tensor_x - pad_x) / scale_x.
+struct Transform {
+  double scale_x;
+  double scale_y;
+  double pad_x;
+  double pad_y;
+};
+
+// The centered rect of a |width| x |height| frame resized into the tensor with
+// its aspect ratio preserved.
+Rect GetLetterboxRect(size_t width,
+                      size_t height,
+                      size_t tensor_width,
+                      size_t tensor_height);
+Transform GetTransform(const Rect& target, size_t width, size_t height);
+
+// Converts |frame| into |tensor| in a single pass, resizing it bilinearly if
+// its size differs from the target. Large frames are split by rows across
+// threads.
+void FillTensor(const Frame& frame, const Tensor& tensor);
+
+// Averages the luma of |frame| over a |grid_width| x |grid_height| grid of
+// cells into |grid|, row by row, in [0, 1]. The grid should not be larger
+// than the frame.
+void GetLumaGrid(const Frame& frame,
+                 size_t grid_width,
+                 size_t grid_height,
+                 std::vector<float>* grid);
+
+}  // namespace image
+
+}  // namespace ienodejs
+
+#endif  // IE_NODE_IMAGE_UTILS_H
@@ -2,7 +2,12 @@
 #define IE_INFER_REQUEST_H
 
 #include <napi.h>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
 
+#include "blob_arena.h"
 #include "inference_engine.hpp"
 
 namespace ienodejs {
@@ -11,17 +16,99 @@ class InferRequest : public Napi::ObjectWrap<InferRequest> {
  public:
   static void Init(const Napi::Env& env);
   static Napi::Value NewInstance(const Napi::Env& env,
-                                 const InferenceEngine::InferRequest& actual);
+                                 const InferenceEngine::InferRequest& actual,
+                                 const std::shared_ptr<BlobArena>& arena,
+                                 const std::vector<std::string>& output_names,
+                                 int64_t external_memory);
   InferRequest(const Napi::CallbackInfo& info);
+  ~InferRequest();
 
  private:
+  friend class InferAsyncWorker;
+  friend class RunAsyncWorker;
+
   static Napi::FunctionReference constructor;
   // APIs
   Napi::Value GetBlob(const Napi::CallbackInfo& info);
+  void SetBlob(const Napi::CallbackInfo& info);
+  void SetNV12Blob(const Napi::CallbackInfo& info) {
+    SetYUVBlob(info, InferenceEngine::ColorFormat::NV12);
+  }
+  void SetI420Blob(const Napi::CallbackInfo& info) {
+    SetYUVBlob(info, InferenceEngine::ColorFormat::I420);
+  }
   Napi::Value Infer(const Napi::CallbackInfo& info);
   Napi::Value StartAsync(const Napi::CallbackInfo& info);
+  Napi::Value Run(const Napi::CallbackInfo& info);
+  Napi::Value AttachRingBuffer(const Napi::CallbackInfo& info);
+  void DetachRingBuffer(const Napi::CallbackInfo& info);
+  Napi::Value QueryState(const Napi::CallbackInfo& info);
+  Napi::Value GetStates(const Napi::CallbackInfo& info);
+  void SetStates(const Napi::CallbackInfo& info);
+  void ResetStates(const Napi::CallbackInfo& info);
+  void UnbindBlobs(const Napi::CallbackInfo& info);
+  void ReleaseBlobs(const Napi::CallbackInfo& info);
+  void Dispose(const Napi::CallbackInfo& info);
+
+  // Helpers
+  // Throws and returns true if dispose() has been called.
+  bool CheckDisposed(const Napi::Env& env);
+  Napi::Value RejectDisposed(const Napi::Env& env,
+                             Napi::Promise::Deferred& deferred);
+  // Binds the Y and chroma planes of a frame as one NV12 or I420 blob.
+  void SetYUVBlob(const Napi::CallbackInfo& info,
+                  const InferenceEngine::ColorFormat& format);
+  // Leases a blob set from the arena if there is one and no lease is held.
+  // Returns false if the arena is exhausted.
+  bool AcquireBlobs();
+  // Rebinds the own blobs, releases the Blobs that getBlob returned from the
+  // lease and returns it to the arena.
+  void ReleaseLease();
+  // Called when an inference completes. Returns the lease if only the
+  // inferences took it, or releases the request if it has been disposed.
+  void OnInferenceDone();
+  // Drops the request, its blobs and the JS objects it references.
+  void Release(const Napi::Env& env);
+  // Records the blob the request was created with for |name| before it is
+  // first replaced.
+  void KeepOwnBlob(const std::string& name);
+  // Records the preprocessing of the input |name|, which setBlob,
+  // setNV12Blob and setI420Blob replace along with the blob.
+  void KeepOwnPreProcess(const std::string& name);
+  // Binds |blob|, one of the own or leased blobs, to |name| with the
+  // preprocessing the request was created with.
+  void BindOwnBlob(const std::string& name,
+                   const InferenceEngine::Blob::Ptr& blob);
+  // Rebinds the blobs the request was created with where it still uses the
+  // blobs of |set|, so that the set can go back to the arena.
+  void RebindOwnBlobs(const BlobArena::BlobSet& set);
+  // Copies the window of every attached ring buffer into its input blob.
+  void CopyRingBuffers();
 
   InferenceEngine::InferRequest actual_;
+  std::shared_ptr<BlobArena> arena_;
+  std::shared_ptr<BlobArena::BlobSet> lease_;
+  // The blobs the request was created with, by the name of a leased or bound
+  // blob. With an arena they are the arena's idle set.
+  InferenceEngine::BlobMap own_blobs_;
+  // The preprocessing of the inputs in |own_blobs_|, by input name.
+  std::map<std::string, InferenceEngine::PreProcessInfo> own_pre_process_;
+  // Whether getBlob took the lease, which is then kept until releaseBlobs().
+  bool keep_lease_ = false;
+  // Weak references to the Blobs that getBlob returned from the lease.
+  std::vector<Napi::ObjectReference> leased_blobs_;
+  // The number of inferences that have not completed.
+  int running_ = 0;
+  // JS objects whose memory backs the blobs set by setBlob, by blob name.
+  std::map<std::string, Napi::ObjectReference> bound_objects_;
+  std::vector<std::string> output_names_;
+  // Output TypedArrays reused by run() when the caller provides none.
+  std::map<std::string, Napi::ObjectReference> output_arrays_;
+  // Ring buffers attached by attachRingBuffer, by input name.
+  std::map<std::string, Napi::ObjectReference> ring_buffers_;
+  bool disposed_ = false;
+  // Native bytes reported to V8 through AdjustExternalMemory.
+  int64_t external_memory_ = 0;
 };
 
 }  // namespace ienodejs
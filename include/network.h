@@ -16,6 +16,7 @@ class Network : public Napi::ObjectWrap<Network> {
                                const InferenceEngine::Core& core,
                                Napi::Promise::Deferred& deferred);
   Network(const Napi::CallbackInfo& info);
+  ~Network();
 
  private:
   friend class Core;
@@ -27,10 +28,21 @@ class Network : public Napi::ObjectWrap<Network> {
   Napi::Value GetName(const Napi::CallbackInfo& info);
   Napi::Value GetInputsInfo(const Napi::CallbackInfo& info);
   Napi::Value GetOutputsInfo(const Napi::CallbackInfo& info);
+  void Dispose(const Napi::CallbackInfo& info);
+
+  // Helpers
+  // Throws and returns true if dispose() has been called.
+  bool CheckDisposed(const Napi::Env& env);
 
   std::string model_;
   std::string weights_;
   InferenceEngine::CNNNetwork actual_;
+  bool disposed_ = false;
+  // Byte size of the weights, an estimate of the memory held by the network
+  // and by the executable networks loaded from it.
+  int64_t weights_byte_size_ = 0;
+  // Native bytes reported to V8 through AdjustExternalMemory.
+  int64_t external_memory_ = 0;
 };
 
 }  // namespace ienodejs
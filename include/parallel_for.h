@@ -0,0 +1,26 @@
+#ifndef IE_NODE_PARALLEL_FOR_H
+#define IE_NODE_PARALLEL_FOR_H
+
+#include <cstddef>
+#include <functional>
+
+namespace ienodejs {
+
+namespace utils {
+
+// Calls |body(begin, end)| over [0, count), split into at most one range per
+// hardware thread and at least |grain| items per range. The ranges run on a
+// thread pool shared by every caller, which is created on first use, and on
+// the calling thread, which returns when every range is done. A call made
+// from inside a range that runs in parallel is not split again, so that
+// nested loops, such as the rows of each image of a batch, do not queue a
+// range per core for each outer range.
+void ParallelFor(size_t count,
+                 size_t grain,
+                 const std::function<void(size_t, size_t)>& body);
+
+}  // namespace utils
+
+}  // namespace ienodejs
+
+#endif  // IE_NODE_PARALLEL_FOR_H
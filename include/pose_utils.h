@@ -0,0 +1,68 @@
+#ifndef IE_NODE_POSE_UTILS_H
+#define IE_NODE_POSE_UTILS_H
+
+#include <cstddef>
+#include <vector>
+
+namespace ienodejs {
+
+namespace pose {
+
+// A point in heatmap cells, at the center of the cell for whole values.
+struct Keypoint {
+  float x;
+  float y;
+  float score;
+};
+
+// A connection between two keypoint types and the channels of the part
+// affinity field along it.
+struct Limb {
+  size_t from;
+  size_t to;
+  size_t paf_x;
+  size_t paf_y;
+};
+
+struct PoseOptions {
+  // The minimum heatmap value of a peak.
+  float threshold = 0.1f;
+  // The limbs of the skeleton, parents first.
+  std::vector<Limb> limbs;
+  // The points sampled along a candidate limb, of which |success_ratio|
+  // should have a field aligned with it by at least |min_paf_score|.
+  size_t samples = 10;
+  float min_paf_score = 0.05f;
+  float success_ratio = 0.8f;
+  // Poses with fewer keypoints or a lower score per keypoint are dropped.
+  size_t min_keypoints = 3;
+  float min_mean_score = 0.2f;
+};
+
+struct Pose {
+  // One per keypoint type; a score of 0 marks a missing keypoint.
+  std::vector<Keypoint> keypoints;
+  float score;
+};
+
+// Finds the local maxima of at least |threshold| in a heatmap, refined to
+// sub-cell precision by a quadratic fit across their neighbours.
+std::vector<Keypoint> FindPeaks(const float* heatmap,
+                                size_t width,
+                                size_t height,
+                                float threshold);
+
+// Groups the peaks of each keypoint type into poses by the part affinity
+// fields |pafs|, planes of |width| x |height|. Returns the poses by
+// descending score.
+std::vector<Pose> GroupPoses(const std::vector<std::vector<Keypoint>>& peaks,
+                             const float* pafs,
+                             size_t width,
+                             size_t height,
+                             const PoseOptions& options);
+
+}  // namespace pose
+
+}  // namespace ienodejs
+
+#endif  // IE_NODE_POSE_UTILS_H
@@ -0,0 +1,34 @@
+#ifndef IE_NODE_POST_PROCESSING_H
+#define IE_NODE_POST_PROCESSING_H
+
+#include <napi.h>
+#include <string>
+
+#include "detection_utils.h"
+
+namespace ienodejs {
+
+// Native output decoders, exported as the postProcessing object that the JS
+// helpers of lib/src/post_processing are added to.
+class PostProcessing {
+ public:
+  static void Init(const Napi::Env& env, Napi::Object exports);
+  // Reads the NMS options of |options|. Returns an error message if any of
+  // them is invalid.
+  static std::string GetNmsOptions(const Napi::Object& options,
+                                   detection::NmsOptions* nms);
+
+ private:
+  // APIs
+  static Napi::Value TopK(const Napi::CallbackInfo& info);
+  static Napi::Value DecodeSSD(const Napi::CallbackInfo& info);
+  static Napi::Value DecodeYolo(const Napi::CallbackInfo& info);
+  static Napi::Value SegmentationMask(const Napi::CallbackInfo& info);
+  static Napi::Value DecodePose(const Napi::CallbackInfo& info);
+  static Napi::Value Nms(const Napi::CallbackInfo& info);
+  static Napi::Value MergeTiledDetections(const Napi::CallbackInfo& info);
+};
+
+}  // namespace ienodejs
+
+#endif  // IE_NODE_POST_PROCESSING_H
@@ -0,0 +1,54 @@
+#ifndef IE_NODE_RING_BUFFER_H
+#define IE_NODE_RING_BUFFER_H
+
+#include <napi.h>
+#include <cstdint>
+#include <vector>
+
+#include "inference_engine.hpp"
+
+namespace ienodejs {
+
+// Keeps the newest |window| samples of a stream for an input of an infer
+// request, which copies them into the input blob before every inference.
+class RingBuffer : public Napi::ObjectWrap<RingBuffer> {
+ public:
+  static void Init(const Napi::Env& env);
+  static Napi::Value NewInstance(const Napi::Env& env,
+                                 const InferenceEngine::Precision& precision,
+                                 size_t window,
+                                 size_t hop);
+  explicit RingBuffer(const Napi::CallbackInfo& info);
+
+  // Writes the window, oldest sample first, to |data| with at most two
+  // copies. Samples not appended yet are written as zeros.
+  void CopyWindow(void* data, size_t byte_size);
+
+ private:
+  static Napi::FunctionReference constructor;
+  // APIs
+  Napi::Value Append(const Napi::CallbackInfo& info);
+  void Reset(const Napi::CallbackInfo& info);
+  Napi::Value IsReady(const Napi::CallbackInfo& info);
+  Napi::Value GetWindow(const Napi::CallbackInfo& info);
+  Napi::Value GetHop(const Napi::CallbackInfo& info);
+  Napi::Value GetPending(const Napi::CallbackInfo& info);
+
+  // True once a window has been appended and a hop since the last copy.
+  bool Ready() const;
+
+  InferenceEngine::Precision precision_;
+  size_t element_size_ = 0;
+  size_t window_ = 0;
+  size_t hop_ = 0;
+  std::vector<uint8_t> storage_;
+  // The element written next, which is the oldest one once the buffer wrapped.
+  size_t head_ = 0;
+  uint64_t total_ = 0;
+  // Elements appended since the last copy.
+  uint64_t pending_ = 0;
+};
+
+}  // namespace ienodejs
+
+#endif  // IE_NODE_RING_BUFFER_H
@@ -0,0 +1,43 @@
+#ifndef IE_NODE_SEGMENTATION_UTILS_H
+#define IE_NODE_SEGMENTATION_UTILS_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ienodejs {
+
+namespace segmentation {
+
+// Writes the index of the highest of |channels| planes of |width| x |height|
+// scores to each pixel of |mask|, the first one on ties. There should be at
+// most 256 channels. A single plane already holds the class of each pixel,
+// as the output of a model that ends with an ArgMax does.
+void ArgMax(const float* scores,
+            size_t channels,
+            size_t width,
+            size_t height,
+            uint8_t* mask);
+
+// Scales |mask| to |output| by the nearest pixel centers.
+void ResizeNearest(const uint8_t* mask,
+                   size_t width,
+                   size_t height,
+                   uint8_t* output,
+                   size_t output_width,
+                   size_t output_height);
+
+// Like ArgMax on the scores bilinearly scaled to the output size, which
+// gives smoother class borders than scaling the mask.
+void ArgMaxBilinear(const float* scores,
+                    size_t channels,
+                    size_t width,
+                    size_t height,
+                    uint8_t* output,
+                    size_t output_width,
+                    size_t output_height);
+
+}  // namespace segmentation
+
+}  // namespace ienodejs
+
+#endif  // IE_NODE_SEGMENTATION_UTILS_H
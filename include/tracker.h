@@ -0,0 +1,48 @@
+#ifndef IE_NODE_TRACKER_H
+#define IE_NODE_TRACKER_H
+
+#include <napi.h>
+#include <cstdint>
+#include <vector>
+
+#include "tracking_utils.h"
+
+namespace ienodejs {
+
+// Tracks the detections of one video stream across frames, so the detector
+// only has to run every detectionInterval frames. The boxes of the frames in
+// between are predicted.
+class Tracker : public Napi::ObjectWrap<Tracker> {
+ public:
+  static void Init(const Napi::Env& env, Napi::Object exports);
+  explicit Tracker(const Napi::CallbackInfo& info);
+
+ private:
+  static Napi::FunctionReference constructor;
+  // APIs
+  Napi::Value Update(const Napi::CallbackInfo& info);
+  Napi::Value Predict(const Napi::CallbackInfo& info);
+  void Reset(const Napi::CallbackInfo& info);
+  Napi::Value NeedsDetection(const Napi::CallbackInfo& info);
+  Napi::Value GetDetectionInterval(const Napi::CallbackInfo& info);
+  void SetDetectionInterval(const Napi::CallbackInfo& info,
+                            const Napi::Value& value);
+
+  // Helpers
+  // The rows of the tracks that matched in the last detection round.
+  Napi::Float32Array CreateTrackArray(const Napi::Env& env) const;
+
+  tracking::TrackerOptions options_;
+  uint32_t detection_interval_ = 1;
+  // Detections with a lower confidence are ignored.
+  float threshold_ = 0.0f;
+
+  std::vector<tracking::Track> tracks_;
+  uint32_t next_id_ = 1;
+  // The frames to predict before the next detection is due.
+  uint32_t frames_until_detection_ = 0;
+};
+
+}  // namespace ienodejs
+
+#endif  // IE_NODE_TRACKER_H
@@ -0,0 +1,84 @@
+#ifndef IE_NODE_TRACKING_UTILS_H
+#define IE_NODE_TRACKING_UTILS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "detection_utils.h"
+
+namespace ienodejs {
+
+namespace tracking {
+
+// A constant velocity Kalman filter of a box, as in SORT: the center, the
+// area and the aspect ratio, with velocities for the first three. The
+// coordinates are independent, so each one has a 2x2 covariance.
+class BoxFilter {
+ public:
+  explicit BoxFilter(const detection::Detection& box);
+
+  // Advances the state by one frame.
+  void Predict();
+  void Update(const detection::Detection& box);
+  // Writes the box of the current state to the corners of |box|.
+  void GetBox(detection::Detection* box) const;
+
+ private:
+  struct Axis {
+    float value;
+    float velocity;
+    // The covariance [[p00, p01], [p01, p11]].
+    float p00;
+    float p01;
+    float p11;
+  };
+
+  static void Predict(Axis* axis, float q_value, float q_velocity);
+  static void Update(Axis* axis, float measurement, float r);
+
+  // The center, the area and the width over height.
+  Axis x_;
+  Axis y_;
+  Axis area_;
+  float ratio_;
+  float ratio_variance_;
+};
+
+struct Track {
+  uint32_t id;
+  BoxFilter filter;
+  // The label and confidence of the last matched detection.
+  float label;
+  float confidence;
+  uint32_t hits;
+  // The detection rounds since the last match.
+  uint32_t misses;
+};
+
+struct TrackerOptions {
+  float iou_threshold = 0.3f;
+  // Tracks are dropped after missing this many detection rounds.
+  uint32_t max_age = 2;
+  // Tracks are reported after this many matches.
+  uint32_t min_hits = 1;
+  // Detections only match tracks of their label unless set.
+  bool class_agnostic = false;
+};
+
+// Advances every track by one frame.
+void PredictTracks(std::vector<Track>* tracks);
+
+// Matches |detections| to the predicted |tracks| by greedy IOU, updates the
+// matched tracks, ages the others and starts a track for each unmatched
+// detection with the ids from |next_id|.
+void UpdateTracks(const std::vector<detection::Detection>& detections,
+                  const TrackerOptions& options,
+                  std::vector<Track>* tracks,
+                  uint32_t* next_id);
+
+}  // namespace tracking
+
+}  // namespace ienodejs
+
+#endif  // IE_NODE_TRACKING_UTILS_H
@@ -2,6 +2,9 @@
 #define IE_NODE_UTILS_H
 
 #include <napi.h>
+#include <string>
+
+#include "image_utils.h"
 #include "inference_engine.hpp"
 
 namespace ienodejs {
@@ -9,6 +12,9 @@ namespace ienodejs {
 namespace utils {
 
 bool checkTensorDesc(const Napi::Object& tensorDesc);
+// |tensorDesc| should have passed checkTensorDesc.
+InferenceEngine::TensorDesc GetTensorDescFromObject(
+    const Napi::Object& tensorDesc);
 
 bool IsValidLayoutName(const std::string& name);
 InferenceEngine::Layout GetLayoutByName(const std::string& name);
@@ -33,6 +39,33 @@ bool IsMeanVariantName(const std::string& name);
 InferenceEngine::MeanVariant GetMeanVariantByName(const std::string& name);
 std::string GetNameOfMeanVariant(
     const InferenceEngine::MeanVariant& meanvariant);
+
+InferenceEngine::Blob::Ptr AllocateBlob(
+    const InferenceEngine::TensorDesc& desc);
+// Creates a blob over |data| without copying. The caller keeps |data| alive.
+InferenceEngine::Blob::Ptr WrapBlob(const InferenceEngine::TensorDesc& desc,
+                                    void* data);
+
+bool IsTypedArrayOfPrecision(const napi_typedarray_type& type,
+                             const InferenceEngine::Precision& precision);
+// Works for TypedArrays backed by an ArrayBuffer or a SharedArrayBuffer.
+void* GetTypedArrayData(const Napi::TypedArray& array);
+// Points |data| at the bytes of an ArrayBuffer, Uint8Array or
+// Uint8ClampedArray. Returns false for any other value.
+bool GetBytes(const Napi::Value& value,
+              const uint8_t** data,
+              size_t* byte_length);
+Napi::TypedArray CreateTypedArray(const Napi::Env& env,
+                                  const InferenceEngine::Precision& precision,
+                                  size_t length);
+size_t GetByteSizeOfTensorDesc(const InferenceEngine::TensorDesc& desc);
+// Describes one batch item of a 3-channel image blob as an image::Tensor
+// without data, in BGR with no normalization. Returns an error message if
+// |desc| cannot hold an image.
+std::string GetImageTensor(const InferenceEngine::TensorDesc& desc,
+                           image::Tensor* tensor);
+Napi::Object CreateTensorDescObject(const Napi::Env& env,
+                                    const InferenceEngine::TensorDesc& desc);
 }  // namespace utils
 
 }  // namespace ienodejs
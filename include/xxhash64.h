@@ -0,0 +1,31 @@
+#ifndef IE_NODE_XXHASH64_H
+#define IE_NODE_XXHASH64_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ienodejs {
+
+namespace utils {
+
+// Streaming XXH64, a fast non-cryptographic hash for content addressing.
+class XXHash64 {
+ public:
+  explicit XXHash64(uint64_t seed = 0);
+  void Update(const void* data, size_t size);
+  uint64_t Digest() const;
+
+ private:
+  uint64_t state_[4];
+  uint64_t seed_;
+  uint64_t total_size_ = 0;
+  // Input not yet consumed by a full 32-byte stripe.
+  uint8_t buffer_[32];
+  size_t buffer_size_ = 0;
+};
+
+}  // namespace utils
+
+}  // namespace ienodejs
+
+#endif  // IE_NODE_XXHASH64_H
@@ -0,0 +1,118 @@
+// Runs several executable networks on the same inputs. Every request binds the
+// input Blobs or TypedArrays with setBlob, so they are filled once and never
+// copied, and the requests start together. The inputs are unbound when the
+// inference is done, so idle requests do not keep them alive.
+//
+// With |shadow| the first network is the primary one and run() resolves with
+// its outputs alone. The other networks are shadows that only run when one of
+// their |maxShadowRequests| requests is idle, so they never queue behind each
+// other or hold back the primary. Shadows copy the inputs into their own
+// blobs when they start, so the caller may reuse the inputs once run()
+// resolves. Their results, or errors, are passed to
+// |onShadowResult(error, outputs, index)| with the index of the network.
+class Ensemble {
+    constructor(execNets, {
+        shadow = false,
+        maxShadowRequests = 1,
+        onShadowResult = () => {}
+    } = {}) {
+        if (!Array.isArray(execNets) || execNets.length === 0) {
+            throw new TypeError('execNets should be a non-empty array');
+        }
+        if (!(maxShadowRequests >= 1)) {
+            throw new RangeError('maxShadowRequests should be at least 1');
+        }
+        this.execNets = execNets;
+        this.shadow = shadow;
+        this.maxShadowRequests = maxShadowRequests;
+        this.onShadowResult = onShadowResult;
+        // Idle infer requests and the number of running ones, by network.
+        this.idle = execNets.map(() => []);
+        this.running = execNets.map(() => 0);
+        this.stats = {runs: 0, shadowRuns: 0, shadowSkips: 0};
+    }
+
+    // Resolves with the outputs of every network, in the order of the
+    // networks, or of the primary network alone in shadow mode. |inputs| is an
+    // object of Blobs or TypedArrays by input name; they must not change until
+    // run() resolves.
+    run(inputs) {
+        this.stats.runs++;
+        const primary = this.infer(0, inputs);
+        if (!this.shadow) {
+            const others = this.execNets.slice(1).map(
+                (execNet, i) => this.infer(i + 1, inputs));
+            return Promise.all([primary, ...others]);
+        }
+        for (let i = 1; i < this.execNets.length; ++i) {
+            if (this.running[i] >= this.maxShadowRequests) {
+                this.stats.shadowSkips++;
+                continue;
+            }
+            this.stats.shadowRuns++;
+            this.infer(i, inputs, true).then(
+                (outputs) => this.onShadowResult(null, outputs, i),
+                (error) => this.onShadowResult(error, null, i));
+        }
+        return primary;
+    }
+
+    getStats() {
+        return {...this.stats, running: this.running.slice()};
+    }
+
+    // Binds |inputs| to a request of the network |index|, or copies them into
+    // its blobs with |copy|, and resolves with copies of its outputs. The
+    // inputs are bound or copied before the first await, so within run().
+    async infer(index, inputs, copy = false) {
+        const request =
+            this.idle[index].pop() || this.execNets[index].createInferRequest();
+        this.running[index]++;
+        try {
+            for (const name of Object.keys(inputs)) {
+                if (copy) {
+                    copyInput(request, name, inputs[name]);
+                } else {
+                    request.setBlob(name, inputs[name]);
+                }
+            }
+            // No input is given to run(), so only the outputs are copied.
+            const outputs = await request.run({});
+            // run() reuses its output arrays, so the caller gets copies.
+            const copies = {};
+            for (const name of Object.keys(outputs)) {
+                copies[name] = outputs[name].slice();
+            }
+            return copies;
+        } finally {
+            // Idle requests do not keep the inputs of the last run alive.
+            request.unbindBlobs();
+            this.running[index]--;
+            this.idle[index].push(request);
+        }
+    }
+}
+
+// Copies the bytes of a Blob or TypedArray into the input blob |name| of
+// |request|.
+function copyInput(request, name, input) {
+    const blob = request.getBlob(name);
+    const source = ArrayBuffer.isView(input) ?
+        new Uint8Array(input.buffer, input.byteOffset, input.byteLength) :
+        new Uint8Array(input.rmap());
+    try {
+        if (source.byteLength !== blob.byteSize()) {
+            throw new RangeError(`The input ${name} does not match the dims`);
+        }
+        new Uint8Array(blob.wmap()).set(source);
+        blob.unmap();
+    } finally {
+        if (!ArrayBuffer.isView(input)) {
+            input.unmap();
+        }
+    }
+}
+
+module.exports = {
+    Ensemble
+}
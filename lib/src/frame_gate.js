@@ -0,0 +1,35 @@
+// Adds FrameGate.run, which puts a gate in front of an infer request.
+function extendFrameGate(FrameGate) {
+    // Fills the input |inputName| of |inferRequest| from the frame and runs
+    // it, unless the gate finds the frame unchanged since the last inferred
+    // one. Resolves with copies of the outputs of InferRequest.run, which are
+    // those of the last inference for skipped frames.
+    FrameGate.prototype.run = async function(
+        inferRequest, inputName, pixels, width, height, fillOptions = {}) {
+        const changed = this.check(
+            pixels, width, height, {format: fillOptions.format || 'rgba'});
+        if (!changed && this.outputs) {
+            return this.outputs;
+        }
+        try {
+            inferRequest.getBlob(inputName).fillFromImage(
+                pixels, width, height, fillOptions);
+            const outputs = await inferRequest.run({});
+            // run() reuses its output arrays, so the gate keeps copies.
+            this.outputs = {};
+            for (const name of Object.keys(outputs)) {
+                this.outputs[name] = outputs[name].slice();
+            }
+        } catch (error) {
+            // The frame was not inferred, so it cannot serve as reference.
+            this.reset();
+            throw error;
+        }
+        return this.outputs;
+    }
+    return FrameGate;
+}
+
+module.exports = {
+    extendFrameGate
+}
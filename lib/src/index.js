@@ -1,6 +1,20 @@
 const postProcessing = require('./post_processing')
+const {allocateSharedBlob} = require('./shared_memory')
+const {Ensemble} = require('./ensemble')
+const {extendFrameGate} = require('./frame_gate')
+const {defineResultCache} = require('./result_cache')
+const {computeTiles, detectTiled} = require('./tiling')
 
 module.exports = function(inferenceEngine) {
-    inferenceEngine.postProcessing = postProcessing
+    // The native decoders and the JS helpers share one namespace.
+    inferenceEngine.postProcessing =
+        Object.assign(inferenceEngine.postProcessing || {}, postProcessing)
+    inferenceEngine.allocateSharedBlob = allocateSharedBlob
+    extendFrameGate(inferenceEngine.FrameGate)
+    inferenceEngine.ResultCache = defineResultCache(inferenceEngine.hashBytes)
+    inferenceEngine.Ensemble = Ensemble
+    inferenceEngine.computeTiles = computeTiles
+    inferenceEngine.detectTiled =
+        detectTiled.bind(null, inferenceEngine.postProcessing)
     return inferenceEngine
 }
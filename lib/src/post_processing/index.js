@@ -1,7 +1,9 @@
 const classification = require('./classification');
 const objectDetection = require('./object_detection');
+const yolo = require('./yolo');
 
 module.exports = {
     ...classification,
-    ...objectDetection
+    ...objectDetection,
+    ...yolo
 }
@@ -24,6 +24,24 @@ class ObjectDetectionPrediction {
     }
 }
 
+// Maps predictions in input coordinates back to the source image using the
+// transform returned by Blob.fillFromImage or decodeImageInto. Set
+// |normalized| when the boxes are fractions of the input size, as SSD
+// DetectionOutput boxes are. The mapped boxes are in source pixels.
+function mapToSource(predictions, transform, normalized = true) {
+    const sx = normalized ? transform.inputWidth : 1;
+    const sy = normalized ? transform.inputHeight : 1;
+    const clamp = (value, max) => Math.min(Math.max(value, 0), max);
+    const mapX = (x) => clamp(
+        (x * sx - transform.padX) / transform.scaleX, transform.sourceWidth);
+    const mapY = (y) => clamp(
+        (y * sy - transform.padY) / transform.scaleY, transform.sourceHeight);
+    return predictions.map((p) => new ObjectDetectionPrediction(
+        mapX(p.x1), mapY(p.y1), mapX(p.x2), mapY(p.y2), p.probability,
+        p.classId));
+}
+
 module.exports = {
     ObjectDetectionPrediction,
+    mapToSource
 }
@@ -0,0 +1,36 @@
+// Anchors and masks of the published YOLO models for decodeYolo, in input
+// pixels. The masks follow the order of the outputs from the coarsest scale,
+// and the outputs of an IR should be passed in that order.
+const yoloConfigs = {
+    yolov3: {
+        classes: 80,
+        inputWidth: 416,
+        inputHeight: 416,
+        anchors: [
+            10, 13, 16, 30, 33, 23, 30, 61, 62, 45, 59, 119, 116, 90, 156,
+            198, 373, 326
+        ],
+        masks: [[6, 7, 8], [3, 4, 5], [0, 1, 2]]
+    },
+    yolov3Tiny: {
+        classes: 80,
+        inputWidth: 416,
+        inputHeight: 416,
+        anchors: [10, 14, 23, 27, 37, 58, 81, 82, 135, 169, 344, 319],
+        masks: [[3, 4, 5], [0, 1, 2]]
+    },
+    yolov4: {
+        classes: 80,
+        inputWidth: 608,
+        inputHeight: 608,
+        anchors: [
+            12, 16, 19, 36, 40, 28, 36, 75, 76, 55, 72, 146, 142, 110, 192,
+            243, 459, 401
+        ],
+        masks: [[6, 7, 8], [3, 4, 5], [0, 1, 2]]
+    }
+}
+
+module.exports = {
+    yoloConfigs
+}
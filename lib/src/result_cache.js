@@ -0,0 +1,123 @@
+// Defines ResultCache over the native hashBytes.
+function defineResultCache(hashBytes) {
+    const networkIds = new WeakMap();
+    let nextNetworkId = 0;
+
+    // Caches the outputs of ExecutableNetwork inference by the content of the
+    // inputs, in a least-recently-used map bounded by |maxBytes| of outputs.
+    // Identical inputs that arrive while their inference runs wait for it
+    // instead of starting another one.
+    class ResultCache {
+        constructor({maxBytes = 64 * 1024 * 1024} = {}) {
+            this.maxBytes = maxBytes;
+            // The cached outputs by key, least recently used first.
+            this.entries = new Map();
+            this.bytes = 0;
+            // The promises of the inferences in flight by key.
+            this.pending = new Map();
+            // Idle infer requests by executable network.
+            this.requests = new WeakMap();
+            this.stats = {hits: 0, misses: 0, coalesced: 0, evictions: 0};
+        }
+
+        // Resolves with the outputs of |execNet| for |inputs|, an object of
+        // TypedArrays by input name. Cached outputs are shared between
+        // callers and must not be modified.
+        run(execNet, inputs) {
+            const key = this.keyOf(execNet, inputs);
+            const entry = this.entries.get(key);
+            if (entry) {
+                this.entries.delete(key);
+                this.entries.set(key, entry);
+                this.stats.hits++;
+                return Promise.resolve(entry.outputs);
+            }
+            const pending = this.pending.get(key);
+            if (pending) {
+                this.stats.coalesced++;
+                return pending;
+            }
+            this.stats.misses++;
+            const promise = (async () => {
+                try {
+                    const outputs = await this.infer(execNet, inputs);
+                    this.store(key, outputs);
+                    return outputs;
+                } finally {
+                    this.pending.delete(key);
+                }
+            })();
+            this.pending.set(key, promise);
+            return promise;
+        }
+
+        getStats() {
+            return {
+                ...this.stats,
+                entries: this.entries.size,
+                bytes: this.bytes,
+                pending: this.pending.size
+            };
+        }
+
+        clear() {
+            this.entries.clear();
+            this.bytes = 0;
+        }
+
+        // The identity of the network, the input names and sizes and the
+        // hash of the input bytes.
+        keyOf(execNet, inputs) {
+            if (!networkIds.has(execNet)) {
+                networkIds.set(execNet, nextNetworkId++);
+            }
+            const names = Object.keys(inputs).sort();
+            const arrays = names.map((name) => inputs[name]);
+            const sizes = arrays.map((array) => array.byteLength);
+            return `${networkIds.get(execNet)}:${names}:${sizes}:${
+                hashBytes(arrays)}`;
+        }
+
+        async infer(execNet, inputs) {
+            let idle = this.requests.get(execNet);
+            if (!idle) {
+                idle = [];
+                this.requests.set(execNet, idle);
+            }
+            const request = idle.pop() || execNet.createInferRequest();
+            try {
+                const outputs = await request.run(inputs);
+                // run() reuses its output arrays, so the cache keeps copies.
+                const copies = {};
+                for (const name of Object.keys(outputs)) {
+                    copies[name] = outputs[name].slice();
+                }
+                return copies;
+            } finally {
+                idle.push(request);
+            }
+        }
+
+        store(key, outputs) {
+            const byteSize = Object.values(outputs).reduce(
+                (acc, array) => acc + array.byteLength, 0);
+            if (byteSize > this.maxBytes) {
+                return;
+            }
+            this.entries.set(key, {outputs, byteSize});
+            this.bytes += byteSize;
+            while (this.bytes > this.maxBytes) {
+                const [oldest, entry] = this.entries.entries().next().value;
+                this.entries.delete(oldest);
+                this.bytes -= entry.byteSize;
+                this.stats.evictions++;
+            }
+        }
+    }
+
+    return ResultCache;
+}
+
+module.exports = {
+    defineResultCache
+}
@@ -0,0 +1,30 @@
+const typedArrayOfPrecision = {
+    'fp32': Float32Array,
+    'fp16': Uint16Array,
+    'i16': Int16Array,
+    'u16': Uint16Array,
+    'u8': Uint8Array,
+    'i8': Int8Array,
+    'i32': Int32Array
+};
+
+// Binds a SharedArrayBuffer-backed TypedArray as the blob |name| of
+// |inferRequest|. The returned array can be posted to worker_threads and
+// filled there in place.
+function allocateSharedBlob(inferRequest, name) {
+    const desc = inferRequest.getBlob(name).getTensorDesc();
+    const TypedArray = typedArrayOfPrecision[desc.precision];
+    if (!TypedArray) {
+        throw new TypeError(`Unsupported precision ${desc.precision}`);
+    }
+    const length = desc.dims.reduce((acc, dim) => acc * dim, 1);
+    const data = new TypedArray(
+        new SharedArrayBuffer(length * TypedArray.BYTES_PER_ELEMENT));
+    inferRequest.setBlob(name, data);
+    return data;
+}
+
+module.exports = {
+    allocateSharedBlob,
+    typedArrayOfPrecision
+}
@@ -0,0 +1,96 @@
+const {ObjectDetectionPrediction} =
+    require('./post_processing/object_detection')
+
+// Offsets of |tile|-sized windows covering |size| with at least |overlap|
+// shared pixels, spread evenly so the last window ends at the border.
+function tileOffsets(size, tile, overlap) {
+    if (size <= tile) {
+        return [0];
+    }
+    const count = Math.ceil((size - overlap) / (tile - overlap));
+    const step = (size - tile) / (count - 1);
+    return Array.from({length: count}, (_, i) => Math.round(i * step));
+}
+
+// Splits a |width| x |height| image into overlapping tiles of at most
+// |tileWidth| x |tileHeight| pixels. The tiles are rects for the roi option
+// of Blob.fillFromImage, in row-major order.
+function computeTiles(width, height, tileWidth, tileHeight, overlap = 32) {
+    if (overlap < 0 || overlap >= Math.min(tileWidth, tileHeight)) {
+        throw new RangeError('overlap should be smaller than the tile');
+    }
+    const tiles = [];
+    for (const y of tileOffsets(height, tileHeight, overlap)) {
+        for (const x of tileOffsets(width, tileWidth, overlap)) {
+            tiles.push({
+                x,
+                y,
+                width: Math.min(width, tileWidth),
+                height: Math.min(height, tileHeight)
+            });
+        }
+    }
+    return tiles;
+}
+
+// Detects objects in an image larger than the network input by running
+// DetectionOutput (SSD) networks on overlapping tiles of it. The tiles fill
+// the batch items of |requests|, which infer in parallel; the detections are
+// mapped back to the image and merged across tile borders with NMS.
+async function detectTiled(postProcessing, requests, pixels, width, height,
+                           options) {
+    const {
+        inputName,
+        outputName,
+        overlap = 32,
+        threshold = 0.5,
+        iouThreshold = 0.5,
+        metric = 'ios',
+        classAgnostic = false,
+        ...fillOptions
+    } = options;
+    const [batch, , inputHeight, inputWidth] =
+        requests[0].getBlob(inputName).getTensorDesc().dims;
+    const tiles = computeTiles(width, height, inputWidth, inputHeight, overlap);
+    const outputs = [];
+    const transforms = [];
+    let next = 0;
+    const drain = async (request) => {
+        while (next < tiles.length) {
+            const group = tiles.slice(next, next + batch);
+            next += group.length;
+            const input = request.getBlob(inputName);
+            const groupTransforms = group.map((roi, batchIndex) =>
+                input.fillFromImage(pixels, width, height, {
+                    ...fillOptions,
+                    resize: 'letterbox',
+                    roi,
+                    batchIndex
+                }));
+            await request.startAsync();
+            const output = request.getBlob(outputName);
+            outputs.push(new Float32Array(output.rmap()).slice());
+            output.unmap();
+            transforms.push(groupTransforms);
+        }
+    };
+    await Promise.all(requests.map(drain));
+    const merged = postProcessing.mergeTiledDetections(outputs, transforms, {
+        threshold,
+        iouThreshold,
+        metric,
+        classAgnostic
+    });
+    const predictions = [];
+    for (let i = 0; i < merged.length; i += 7) {
+        predictions.push(new ObjectDetectionPrediction(
+            merged[i + 3], merged[i + 4], merged[i + 5], merged[i + 6],
+            merged[i + 2], merged[i + 1]));
+    }
+    return predictions;
+}
+
+module.exports = {
+    computeTiles,
+    detectTiled
+}
@@ -1,14 +1,25 @@
 #include "napi.h"
 
 #include "blob.h"
+#include "cascade.h"
 #include "core.h"
+#include "embedding_index.h"
 #include "executable_network.h"
+#include "frame_gate.h"
 #include "infer_request.h"
 #include "input_info.h"
 #include "network.h"
 #include "output_info.h"
+#include "post_processing.h"
 #include "preprocess_channel.h"
 #include "preprocess_info.h"
+#include "ring_buffer.h"
+#include "tracker.h"
+#include "utils.h"
+#include "xxhash64.h"
+
+#include <cstdio>
+#include <vector>
 
 #include "inference_engine.hpp"
 
@@ -43,8 +54,59 @@ Napi::Object GetVersion(const Napi::CallbackInfo& info) {
   return version;
 }
 
+// hashBytes(data, seed) returns the XXH64 of the bytes of an ArrayBuffer or
+// TypedArray, or of an array of them concatenated, as 16 hex digits.
+Napi::Value HashBytes(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1 || info.Length() > 2) {
+    Napi::TypeError::New(env, "Wrong number of arguments")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  std::vector<Napi::Value> values;
+  if (info[0].IsArray()) {
+    Napi::Array array = info[0].As<Napi::Array>();
+    for (uint32_t i = 0; i < array.Length(); ++i) {
+      values.push_back(array.Get(i));
+    }
+  } else {
+    values.push_back(info[0]);
+  }
+  if (info.Length() == 2 && !info[1].IsNumber()) {
+    Napi::TypeError::New(env, "Wrong type of arguments")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  uint64_t seed = info.Length() == 2 ? info[1].ToNumber().Uint32Value() : 0;
+  utils::XXHash64 hash(seed);
+  for (auto& value : values) {
+    if (value.IsArrayBuffer()) {
+      Napi::ArrayBuffer buffer = value.As<Napi::ArrayBuffer>();
+      hash.Update(buffer.Data(), buffer.ByteLength());
+    } else if (value.IsTypedArray()) {
+      Napi::TypedArray array = value.As<Napi::TypedArray>();
+      hash.Update(utils::GetTypedArrayData(array), array.ByteLength());
+    } else {
+      Napi::TypeError::New(env, "Wrong type of arguments")
+          .ThrowAsJavaScriptException();
+      return env.Null();
+    }
+  }
+
+  char digest[17];
+  std::snprintf(digest, sizeof(digest), "%016llx",
+                static_cast<unsigned long long>(hash.Digest()));
+  return Napi::String::New(env, digest);
+}
+
 Napi::Object Init(Napi::Env env, Napi::Object exports) {
   exports.Set("getVersion", Napi::Function::New(env, GetVersion));
+  exports.Set("hashBytes", Napi::Function::New(env, HashBytes));
+  exports.Set("decodeImageInto",
+              Napi::Function::New(env, Blob::DecodeImageInto));
   Blob::Init(env);
   Core::Init(env, exports);
   Network::Init(env);
@@ -54,6 +116,12 @@ Napi::Object Init(Napi::Env env, Napi::Object exports) {
   PreProcessChannel::Init(env);
   InputInfo::Init(env);
   OutputInfo::Init(env);
+  RingBuffer::Init(env);
+  PostProcessing::Init(env, exports);
+  FrameGate::Init(env, exports);
+  Tracker::Init(env, exports);
+  EmbeddingIndex::Init(env, exports);
+  Cascade::Init(env, exports);
   return exports;
 }
 
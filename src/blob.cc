@@ -1,4 +1,15 @@
 #include "blob.h"
+#include "image_decoder.h"
+#include "image_utils.h"
+#include "parallel_for.h"
+#include "utils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
 
 using namespace Napi;
 
@@ -6,6 +17,247 @@ namespace ie = InferenceEngine;
 
 namespace ienodejs {
 
+namespace {
+
+// Reads three numbers into |values|. Returns false on any other value.
+bool GetChannelValues(const Napi::Value& value, float values[3]) {
+  if (!value.IsArray() || value.As<Napi::Array>().Length() != 3) {
+    return false;
+  }
+  Napi::Array array = value.As<Napi::Array>();
+  for (uint32_t i = 0; i < 3; ++i) {
+    Napi::Value element = array[i];
+    if (!element.IsNumber()) {
+      return false;
+    }
+    values[i] = element.ToNumber().FloatValue();
+  }
+  return true;
+}
+
+// Returns false if |tensor| would write NaN or infinite values, whose
+// conversion to u8 is undefined.
+bool IsFiniteNormalization(const image::Tensor& tensor) {
+  for (size_t k = 0; k < 3; ++k) {
+    if (!std::isfinite(tensor.mean[k]) || !std::isfinite(tensor.std[k]) ||
+        tensor.std[k] == 0.0f) {
+      return false;
+    }
+  }
+  return std::isfinite(tensor.pad);
+}
+
+// Reads an {x, y, width, height} object of non-negative integers into |rect|.
+// Returns false on any other value.
+bool GetRect(const Napi::Value& value, image::Rect* rect) {
+  if (!value.IsObject()) {
+    return false;
+  }
+  Napi::Object object = value.As<Napi::Object>();
+  const char* keys[] = {"x", "y", "width", "height"};
+  size_t* fields[] = {&rect->x, &rect->y, &rect->width, &rect->height};
+  for (size_t i = 0; i < 4; ++i) {
+    Napi::Value field = object.Get(keys[i]);
+    if (!field.IsNumber() || field.ToNumber().DoubleValue() < 0) {
+      return false;
+    }
+    *fields[i] = field.ToNumber().Uint32Value();
+  }
+  return true;
+}
+
+enum class ResizeMode { NONE, STRETCH, LETTERBOX };
+
+// Parses the resize option: a boolean, "none", "stretch" or "letterbox".
+bool GetResizeMode(const Napi::Value& value, ResizeMode* mode) {
+  if (value.IsBoolean()) {
+    *mode = value.ToBoolean() ? ResizeMode::STRETCH : ResizeMode::NONE;
+    return true;
+  }
+  if (!value.IsString()) {
+    return false;
+  }
+  std::string name = value.ToString();
+  if (name == "none") {
+    *mode = ResizeMode::NONE;
+  } else if (name == "stretch") {
+    *mode = ResizeMode::STRETCH;
+  } else if (name == "letterbox") {
+    *mode = ResizeMode::LETTERBOX;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+// Sets the target rect of a |width| x |height| frame in |tensor|. Returns
+// false if |mode| is NONE and the sizes differ.
+bool PlaceFrame(ResizeMode mode,
+                size_t width,
+                size_t height,
+                image::Tensor* tensor) {
+  if (mode == ResizeMode::LETTERBOX) {
+    tensor->target = image::GetLetterboxRect(width, height, tensor->width,
+                                             tensor->height);
+    return true;
+  }
+  tensor->target = {0, 0, tensor->width, tensor->height};
+  return mode == ResizeMode::STRETCH ||
+         (width == tensor->width && height == tensor->height);
+}
+
+// Describes where |region| of a |width| x |height| frame was placed in
+// |tensor|, as a transform from tensor to frame coordinates.
+Napi::Object CreateTransformObject(const Napi::Env& env,
+                                   const image::Tensor& tensor,
+                                   const image::Rect& region,
+                                   size_t width,
+                                   size_t height) {
+  image::Transform transform =
+      image::GetTransform(tensor.target, region.width, region.height);
+  // Folding the region origin into the padding keeps the mapping a single
+  // scale and offset per axis.
+  transform.pad_x -= region.x * transform.scale_x;
+  transform.pad_y -= region.y * transform.scale_y;
+  Napi::Object object = Napi::Object::New(env);
+  object.Set("scaleX", transform.scale_x);
+  object.Set("scaleY", transform.scale_y);
+  object.Set("padX", transform.pad_x);
+  object.Set("padY", transform.pad_y);
+  object.Set("sourceWidth", width);
+  object.Set("sourceHeight", height);
+  object.Set("inputWidth", tensor.width);
+  object.Set("inputHeight", tensor.height);
+  return object;
+}
+
+}  // namespace
+
+// Decodes a batch of encoded images into consecutive batch items of a blob on
+// a worker thread, one image per thread.
+class DecodeImageAsyncWorker : public Napi::AsyncWorker {
+ public:
+  struct Source {
+    const uint8_t* data;
+    size_t size;
+  };
+
+  // |receiver| holds the Blob and the encoded buffers while decoding.
+  DecodeImageAsyncWorker(Napi::Env& env,
+                         const Napi::Object& receiver,
+                         const ie::MemoryBlob::Ptr& blob,
+                         const std::vector<Source>& sources,
+                         const image::Tensor& tensor,
+                         ResizeMode mode,
+                         Napi::Promise::Deferred& deferred)
+      : Napi::AsyncWorker(receiver),
+        blob_(blob),
+        sources_(sources),
+        tensors_(sources.size(), tensor),
+        sizes_(sources.size()),
+        mode_(mode),
+        deferred_(deferred) {}
+
+  void Execute() {
+    try {
+      ie::LockedMemory<void> memory = blob_->wmap();
+      uint8_t* base = memory.as<uint8_t*>();
+      const ie::SizeVector& dims = blob_->getTensorDesc().getDims();
+      size_t item_byte_size = blob_->byteSize() / dims[0];
+      std::vector<std::string> errors(sources_.size());
+      std::vector<bool> range_errors(sources_.size());
+      // The images of a batch are decoded in parallel and the rows of each
+      // one on its thread. A single image splits its rows across threads.
+      utils::ParallelFor(sources_.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+          try {
+            tensors_[i].data = base + i * item_byte_size;
+            Decode(sources_[i], &tensors_[i], &sizes_[i]);
+          } catch (const std::range_error& error) {
+            errors[i] = error.what();
+            range_errors[i] = true;
+          } catch (const std::exception& error) {
+            errors[i] = error.what();
+          }
+        }
+      });
+      for (size_t i = 0; i < errors.size(); ++i) {
+        if (!errors[i].empty()) {
+          range_error_ = range_errors[i];
+          SetError(sources_.size() > 1
+                       ? "Image " + std::to_string(i) + ": " + errors[i]
+                       : errors[i]);
+          return;
+        }
+      }
+    } catch (const std::exception& error) {
+      SetError(error.what());
+    } catch (...) {
+      SetError("Unknown/internal exception happened.");
+    }
+  }
+
+  // Resolves with the transform of the image, or an array of them.
+  void OnOK() {
+    Napi::Env env = Env();
+    Napi::Array transforms = Napi::Array::New(env, sources_.size());
+    for (size_t i = 0; i < sources_.size(); ++i) {
+      const size_t width = sizes_[i].first;
+      const size_t height = sizes_[i].second;
+      transforms.Set(static_cast<uint32_t>(i),
+                     CreateTransformObject(env, tensors_[i],
+                                           {0, 0, width, height}, width,
+                                           height));
+    }
+    if (sources_.size() == 1) {
+      deferred_.Resolve(transforms.Get(0u));
+    } else {
+      deferred_.Resolve(transforms);
+    }
+  }
+
+  void OnError(Napi::Error const& error) {
+    if (range_error_) {
+      deferred_.Reject(Napi::RangeError::New(Env(), error.Message()).Value());
+    } else {
+      deferred_.Reject(error.Value());
+    }
+  }
+
+ private:
+  void Decode(const Source& source,
+              image::Tensor* tensor,
+              std::pair<size_t, size_t>* size) {
+    bool resize = mode_ != ResizeMode::NONE;
+    image::DecodedImage decoded;
+    image::DecodeImage(source.data, source.size, resize ? tensor->width : 0,
+                       resize ? tensor->height : 0, &decoded);
+    // The target rect and transform refer to the size stored in the file even
+    // if DCT scaling decoded a smaller image.
+    if (!PlaceFrame(mode_, decoded.source_width, decoded.source_height,
+                    tensor)) {
+      throw std::runtime_error("The image size does not match the Blob");
+    }
+    *size = std::make_pair(decoded.source_width, decoded.source_height);
+    image::Frame frame;
+    frame.data = decoded.pixels.data();
+    frame.width = decoded.width;
+    frame.height = decoded.height;
+    frame.stride = decoded.width * 3;
+    frame.format = image::PixelFormat::RGB;
+    image::FillTensor(frame, *tensor);
+  }
+
+  ie::MemoryBlob::Ptr blob_;
+  std::vector<Source> sources_;
+  std::vector<image::Tensor> tensors_;
+  std::vector<std::pair<size_t, size_t>> sizes_;
+  ResizeMode mode_;
+  // Whether the error is about an image that is too large.
+  bool range_error_ = false;
+  Napi::Promise::Deferred deferred_;
+};
+
 Napi::FunctionReference Blob::constructor;
 
 void Blob::Init(const Napi::Env& env) {
@@ -14,10 +266,14 @@ void Blob::Init(const Napi::Env& env) {
   Napi::Function func = DefineClass(
       env, "Blob",
       {InstanceMethod("byteSize", &Blob::ByteSize),
-       InstanceMethod("size", &Blob::Size), InstanceMethod("rmap", &Blob::Rmap),
+       InstanceMethod("size", &Blob::Size),
+       InstanceMethod("getTensorDesc", &Blob::GetTensorDesc),
+       InstanceMethod("rmap", &Blob::Rmap),
        InstanceMethod("rwmap", &Blob::Rwmap),
        InstanceMethod("wmap", &Blob::Wmap),
-       InstanceMethod("unmap", &Blob::Unmap)});
+       InstanceMethod("unmap", &Blob::Unmap),
+       InstanceMethod("fillFromImage", &Blob::FillFromImage),
+       InstanceMethod("dispose", &Blob::Dispose)});
 
   constructor = Napi::Persistent(func);
   constructor.SuppressDestruct();
@@ -25,19 +281,39 @@ void Blob::Init(const Napi::Env& env) {
 
 Blob::Blob(const Napi::CallbackInfo& info) : Napi::ObjectWrap<Blob>(info) {}
 
-Napi::Value Blob::NewInstance(const Napi::Env& env,
-                              const ie::Blob::Ptr& actual) {
+bool Blob::GetActual(const Napi::Env& env,
+                     const Napi::Value& value,
+                     ie::Blob::Ptr* actual) {
+  if (!value.IsObject() || !value.ToObject().InstanceOf(constructor.Value())) {
+    return true;
+  }
+  Blob* blob = Napi::ObjectWrap<Blob>::Unwrap(value.ToObject());
+  if (blob->CheckDisposed(env)) {
+    return false;
+  }
+  *actual = blob->actual_;
+  return true;
+}
+
+Napi::Value Blob::NewInstance(
+    const Napi::Env& env,
+    const ie::Blob::Ptr& actual,
+    const std::shared_ptr<BlobArena::BlobSet>& lease) {
   Napi::EscapableHandleScope scope(env);
 
   Napi::Object obj = constructor.New({});
   Blob* blob = Napi::ObjectWrap<Blob>::Unwrap(obj);
   blob->actual_ = actual;
+  blob->lease_ = lease;
 
   return scope.Escape(napi_value(obj)).ToObject();
 }
 
 Napi::Value Blob::Memmap(const Napi::CallbackInfo& info, const int mode) {
   Napi::Env env = info.Env();
+  if (CheckDisposed(env)) {
+    return env.Null();
+  }
   if (info.Length() > 0) {
     Napi::TypeError::New(env, "Invalid argument").ThrowAsJavaScriptException();
     return Napi::Object::New(env);
@@ -66,14 +342,25 @@ Napi::Value Blob::Memmap(const Napi::CallbackInfo& info, const int mode) {
         .ThrowAsJavaScriptException();
     return env.Null();
   }
-  return Napi::ArrayBuffer::New(
+  Napi::ArrayBuffer buffer = Napi::ArrayBuffer::New(
       env,
       locked_memory_->as<ie::PrecisionTrait<ie::Precision::I8>::value_type*>(),
       actual_->byteSize());
+  mapped_buffers_.erase(
+      std::remove_if(mapped_buffers_.begin(), mapped_buffers_.end(),
+                     [](Napi::Reference<Napi::ArrayBuffer>& reference) {
+                       return reference.Value().IsEmpty();
+                     }),
+      mapped_buffers_.end());
+  mapped_buffers_.push_back(Napi::Weak(buffer));
+  return buffer;
 }
 
 Napi::Value Blob::Unmap(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
+  if (CheckDisposed(env)) {
+    return env.Null();
+  }
   if (info.Length() > 0) {
     Napi::TypeError::New(env, "Invalid argument").ThrowAsJavaScriptException();
     return Napi::Object::New(env);
@@ -85,6 +372,9 @@ Napi::Value Blob::Unmap(const Napi::CallbackInfo& info) {
 
 Napi::Value Blob::ByteSize(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
+  if (CheckDisposed(env)) {
+    return env.Null();
+  }
   if (info.Length() > 0) {
     Napi::TypeError::New(env, "Invalid argument").ThrowAsJavaScriptException();
     return Napi::Object::New(env);
@@ -94,6 +384,9 @@ Napi::Value Blob::ByteSize(const Napi::CallbackInfo& info) {
 
 Napi::Value Blob::Size(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
+  if (CheckDisposed(env)) {
+    return env.Null();
+  }
   if (info.Length() > 0) {
     Napi::TypeError::New(env, "Invalid argument").ThrowAsJavaScriptException();
     return Napi::Object::New(env);
@@ -101,4 +394,323 @@ Napi::Value Blob::Size(const Napi::CallbackInfo& info) {
   return Napi::Number::New(env, actual_->size());
 }
 
-}  // namespace ienodejs
\ No newline at end of file
+Napi::Value Blob::GetTensorDesc(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  if (CheckDisposed(env)) {
+    return env.Null();
+  }
+  if (info.Length() > 0) {
+    Napi::TypeError::New(env, "Invalid argument").ThrowAsJavaScriptException();
+    return Napi::Object::New(env);
+  }
+  return utils::CreateTensorDescObject(env, actual_->getTensorDesc());
+}
+
+Napi::Value Blob::FillFromImage(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  if (CheckDisposed(env)) {
+    return env.Null();
+  }
+  if (info.Length() < 3 || info.Length() > 4) {
+    Napi::TypeError::New(env, "Wrong number of arguments")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  const uint8_t* data = nullptr;
+  size_t byte_length = 0;
+  if (!utils::GetBytes(info[0], &data, &byte_length) ||
+      !info[1].IsNumber() || !info[2].IsNumber() ||
+      (info.Length() == 4 && !info[3].IsObject())) {
+    Napi::TypeError::New(env, "Wrong type of arguments")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  image::Frame frame;
+  frame.data = data;
+  frame.width = info[1].ToNumber().Uint32Value();
+  frame.height = info[2].ToNumber().Uint32Value();
+  frame.format = image::PixelFormat::RGBA;
+  image::Rect roi = {0, 0, frame.width, frame.height};
+  size_t batch_index = 0;
+
+  const ie::TensorDesc& desc = actual_->getTensorDesc();
+  image::Tensor tensor;
+  std::string message = utils::GetImageTensor(desc, &tensor);
+  if (!message.empty()) {
+    Napi::TypeError::New(env, message).ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  ResizeMode mode = ResizeMode::NONE;
+  if (info.Length() == 4) {
+    Napi::Object options = info[3].As<Napi::Object>();
+    if (options.Has("format")) {
+      Napi::Value format = options.Get("format");
+      if (!format.IsString() ||
+          !image::IsPixelFormatName(format.ToString().Utf8Value())) {
+        Napi::TypeError::New(env, "Unsupported pixel format")
+            .ThrowAsJavaScriptException();
+        return env.Null();
+      }
+      frame.format = image::GetPixelFormatByName(format.ToString());
+    }
+    if (options.Has("channelOrder")) {
+      std::string order = options.Get("channelOrder").ToString();
+      if (order != "rgb" && order != "bgr") {
+        Napi::TypeError::New(env, "Unsupported channel order")
+            .ThrowAsJavaScriptException();
+        return env.Null();
+      }
+      tensor.bgr = order == "bgr";
+    }
+    if (options.Has("layout")) {
+      std::string layout = options.Get("layout").ToString();
+      bool planar = layout == "nchw";
+      if ((layout != "nchw" && layout != "nhwc") ||
+          (desc.getLayout() == ie::Layout::NCHW && !planar) ||
+          (desc.getLayout() == ie::Layout::NHWC && planar)) {
+        Napi::TypeError::New(env, "The layout does not match the Blob")
+            .ThrowAsJavaScriptException();
+        return env.Null();
+      }
+      tensor.planar = planar;
+    }
+    if (options.Has("resize") &&
+        !GetResizeMode(options.Get("resize"), &mode)) {
+      Napi::TypeError::New(env, "Unsupported resize mode")
+          .ThrowAsJavaScriptException();
+      return env.Null();
+    }
+    if (options.Has("padValue")) {
+      if (!options.Get("padValue").IsNumber()) {
+        Napi::TypeError::New(env, "padValue should be a number")
+            .ThrowAsJavaScriptException();
+        return env.Null();
+      }
+      tensor.pad = options.Get("padValue").ToNumber().FloatValue();
+    }
+    if (options.Has("mean") &&
+        !GetChannelValues(options.Get("mean"), tensor.mean)) {
+      Napi::TypeError::New(env, "mean should be an array of 3 numbers")
+          .ThrowAsJavaScriptException();
+      return env.Null();
+    }
+    if (options.Has("std") &&
+        !GetChannelValues(options.Get("std"), tensor.std)) {
+      Napi::TypeError::New(env, "std should be an array of 3 numbers")
+          .ThrowAsJavaScriptException();
+      return env.Null();
+    }
+    if (options.Has("roi") && !GetRect(options.Get("roi"), &roi)) {
+      Napi::TypeError::New(env, "roi should be an {x, y, width, height} object")
+          .ThrowAsJavaScriptException();
+      return env.Null();
+    }
+    if (options.Has("batchIndex")) {
+      if (!options.Get("batchIndex").IsNumber()) {
+        Napi::TypeError::New(env, "batchIndex should be a number")
+            .ThrowAsJavaScriptException();
+        return env.Null();
+      }
+      batch_index = options.Get("batchIndex").ToNumber().Uint32Value();
+    }
+  }
+
+  if (!IsFiniteNormalization(tensor)) {
+    Napi::RangeError::New(
+        env, "mean, std and padValue should be finite and std non-zero")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  if (frame.width == 0 || frame.height == 0) {
+    Napi::RangeError::New(env, "The image is empty")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  if (roi.width == 0 || roi.height == 0 || roi.x + roi.width > frame.width ||
+      roi.y + roi.height > frame.height) {
+    Napi::RangeError::New(env, "The roi is outside the image")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  if (batch_index >= desc.getDims()[0]) {
+    Napi::RangeError::New(env, "batchIndex is out of range")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  if (!PlaceFrame(mode, roi.width, roi.height, &tensor)) {
+    Napi::RangeError::New(env, "The image size does not match the Blob")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  const size_t bpp = image::GetBytesPerPixel(frame.format);
+  if (byte_length < frame.width * frame.height * bpp) {
+    Napi::RangeError::New(env, "The image data is too short")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  // Only the roi is read, through the row stride of the whole image.
+  image::Frame region;
+  region.data = frame.data + roi.y * frame.width * bpp + roi.x * bpp;
+  region.width = roi.width;
+  region.height = roi.height;
+  region.stride = frame.width * bpp;
+  region.format = frame.format;
+
+  ie::MemoryBlob::Ptr memory_blob = ie::as<ie::MemoryBlob>(actual_);
+  if (!memory_blob) {
+    Napi::TypeError::New(env, "Not able to cast Blob to MemoryBlob")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  try {
+    ie::LockedMemory<void> memory = memory_blob->wmap();
+    size_t item_byte_size = memory_blob->byteSize() / desc.getDims()[0];
+    tensor.data = memory.as<uint8_t*>() + batch_index * item_byte_size;
+    image::FillTensor(region, tensor);
+  } catch (const std::exception& error) {
+    Napi::Error::New(env, error.what()).ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  return CreateTransformObject(env, tensor, roi, frame.width, frame.height);
+}
+
+Napi::Value Blob::DecodeImageInto(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+
+  if (info.Length() < 2 || info.Length() > 3) {
+    deferred.Reject(
+        Napi::TypeError::New(env, "Wrong number of arguments").Value());
+    return deferred.Promise();
+  }
+  if (!info[0].IsObject() ||
+      !info[0].ToObject().InstanceOf(constructor.Value()) ||
+      (info.Length() == 3 && !info[2].IsObject())) {
+    deferred.Reject(
+        Napi::TypeError::New(env, "Wrong type of arguments").Value());
+    return deferred.Promise();
+  }
+
+  Blob* blob = Napi::ObjectWrap<Blob>::Unwrap(info[0].ToObject());
+  if (blob->disposed_) {
+    deferred.Reject(
+        Napi::Error::New(env, "The Blob has been disposed").Value());
+    return deferred.Promise();
+  }
+  ie::MemoryBlob::Ptr memory_blob = ie::as<ie::MemoryBlob>(blob->actual_);
+  image::Tensor tensor;
+  std::string message =
+      memory_blob
+          ? utils::GetImageTensor(blob->actual_->getTensorDesc(), &tensor)
+          : "Not able to cast Blob to MemoryBlob";
+  if (!message.empty()) {
+    deferred.Reject(Napi::TypeError::New(env, message).Value());
+    return deferred.Promise();
+  }
+
+  // A single encoded image or an array of them, one per batch item.
+  std::vector<DecodeImageAsyncWorker::Source> sources;
+  std::vector<Napi::Value> values;
+  if (info[1].IsArray()) {
+    Napi::Array array = info[1].As<Napi::Array>();
+    for (uint32_t i = 0; i < array.Length(); ++i) {
+      values.push_back(array.Get(i));
+    }
+  } else {
+    values.push_back(info[1]);
+  }
+  for (auto& value : values) {
+    DecodeImageAsyncWorker::Source source;
+    if (!utils::GetBytes(value, &source.data, &source.size)) {
+      deferred.Reject(
+          Napi::TypeError::New(env, "Wrong type of arguments").Value());
+      return deferred.Promise();
+    }
+    sources.push_back(source);
+  }
+  if (sources.empty() ||
+      sources.size() > blob->actual_->getTensorDesc().getDims()[0]) {
+    deferred.Reject(
+        Napi::RangeError::New(env, "The images do not match the batch size")
+            .Value());
+    return deferred.Promise();
+  }
+
+  ResizeMode mode = ResizeMode::STRETCH;
+  if (info.Length() == 3) {
+    Napi::Object options = info[2].ToObject();
+    if (options.Has("resize") && !GetResizeMode(options.Get("resize"), &mode)) {
+      deferred.Reject(
+          Napi::TypeError::New(env, "Unsupported resize mode").Value());
+      return deferred.Promise();
+    }
+    if (options.Has("padValue")) {
+      if (!options.Get("padValue").IsNumber()) {
+        deferred.Reject(
+            Napi::TypeError::New(env, "padValue should be a number").Value());
+        return deferred.Promise();
+      }
+      tensor.pad = options.Get("padValue").ToNumber().FloatValue();
+    }
+    if (options.Has("colorFormat")) {
+      std::string format = options.Get("colorFormat").ToString();
+      if (format != "rgb" && format != "bgr") {
+        deferred.Reject(
+            Napi::TypeError::New(env, "Unsupported color format").Value());
+        return deferred.Promise();
+      }
+      tensor.bgr = format == "bgr";
+    }
+  }
+
+  if (!IsFiniteNormalization(tensor)) {
+    deferred.Reject(
+        Napi::RangeError::New(env, "padValue should be finite").Value());
+    return deferred.Promise();
+  }
+
+  Napi::Object receiver = Napi::Object::New(env);
+  receiver.Set("blob", info[0]);
+  receiver.Set("images", info[1]);
+  DecodeImageAsyncWorker* worker = new DecodeImageAsyncWorker(
+      env, receiver, memory_blob, sources, tensor, mode, deferred);
+  worker->Queue();
+  return deferred.Promise();
+}
+
+void Blob::Dispose(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  if (info.Length() > 0) {
+    Napi::TypeError::New(env, "Invalid argument").ThrowAsJavaScriptException();
+    return;
+  }
+
+  Release();
+}
+
+void Blob::Release() {
+  for (auto& reference : mapped_buffers_) {
+    Napi::ArrayBuffer buffer = reference.Value();
+    if (!buffer.IsEmpty() && !buffer.IsDetached()) {
+      buffer.Detach();
+    }
+  }
+  mapped_buffers_.clear();
+  locked_memory_.reset();
+  actual_.reset();
+  lease_.reset();
+  disposed_ = true;
+}
+
+bool Blob::CheckDisposed(const Napi::Env& env) {
+  if (disposed_) {
+    Napi::Error::New(env, "The Blob has been disposed")
+        .ThrowAsJavaScriptException();
+  }
+  return disposed_;
+}
+
+}  // namespace ienodejs
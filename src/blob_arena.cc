@@ -0,0 +1,119 @@
+#include "blob_arena.h"
+#include "utils.h"
+
+namespace ie = InferenceEngine;
+
+namespace ienodejs {
+
+BlobArena::BlobArena(const Napi::Env& env,
+                     const ie::ExecutableNetwork& network,
+                     size_t capacity)
+    : env_(env),
+      capacity_(capacity),
+      allocated_(0),
+      in_use_(0),
+      peak_in_use_(0),
+      leases_(0),
+      exhausted_(0),
+      samples_(0),
+      in_use_sum_(0),
+      set_byte_size_(0) {
+  for (auto& input : network.GetInputsInfo()) {
+    descs_.emplace(input.first, input.second->getTensorDesc());
+  }
+  for (auto& output : network.GetOutputsInfo()) {
+    descs_.emplace(output.first, output.second->getTensorDesc());
+  }
+  for (auto& desc : descs_) {
+    set_byte_size_ += utils::GetByteSizeOfTensorDesc(desc.second);
+  }
+
+  // Every request binds the first set, so it is allocated up front.
+  std::unique_ptr<BlobSet> set = Allocate();
+  idle_set_ = *set;
+  free_sets_.push_back(std::move(set));
+  allocated_++;
+  Napi::MemoryManagement::AdjustExternalMemory(env_, set_byte_size_);
+}
+
+BlobArena::~BlobArena() {
+  Napi::MemoryManagement::AdjustExternalMemory(
+      env_, -static_cast<int64_t>(allocated_ * set_byte_size_));
+}
+
+std::shared_ptr<BlobArena::BlobSet> BlobArena::Acquire() {
+  std::unique_ptr<BlobSet> set;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!free_sets_.empty()) {
+      set = std::move(free_sets_.back());
+      free_sets_.pop_back();
+    } else if (allocated_ < capacity_) {
+      allocated_++;
+    } else {
+      exhausted_++;
+      return nullptr;
+    }
+    in_use_++;
+    leases_++;
+    if (in_use_ > peak_in_use_) {
+      peak_in_use_ = in_use_;
+    }
+    Sample();
+  }
+
+  if (!set) {
+    try {
+      set = Allocate();
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      allocated_--;
+      in_use_--;
+      throw;
+    }
+    // Sets are only acquired on the JS thread.
+    Napi::MemoryManagement::AdjustExternalMemory(env_, set_byte_size_);
+  }
+
+  // The lease returns to the pool when the request and every in-flight
+  // worker holding it have let go.
+  auto self = shared_from_this();
+  return std::shared_ptr<BlobSet>(set.release(),
+                                  [self](BlobSet* set) { self->Recycle(set); });
+}
+
+BlobArena::Stats BlobArena::GetStats() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Stats stats;
+  stats.capacity = capacity_;
+  stats.allocated = allocated_;
+  stats.in_use = in_use_;
+  stats.peak_in_use = peak_in_use_;
+  stats.average_in_use = samples_ > 0 ? in_use_sum_ / samples_ : 0;
+  stats.leases = leases_;
+  stats.exhausted = exhausted_;
+  stats.set_byte_size = set_byte_size_;
+  return stats;
+}
+
+std::unique_ptr<BlobArena::BlobSet> BlobArena::Allocate() {
+  std::unique_ptr<BlobSet> set(new BlobSet());
+  for (auto& desc : descs_) {
+    (*set)[desc.first] = utils::AllocateBlob(desc.second);
+  }
+  return set;
+}
+
+void BlobArena::Recycle(BlobSet* set) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  free_sets_.emplace_back(set);
+  in_use_--;
+  Sample();
+}
+
+void BlobArena::Sample() {
+  samples_++;
+  in_use_sum_ += in_use_;
+}
+
+}  // namespace ienodejs
@@ -0,0 +1,500 @@
+#include "cascade.h"
+#include "classification_utils.h"
+#include "executable_network.h"
+#include "parallel_for.h"
+#include "post_processing.h"
+#include "utils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace Napi;
+
+namespace ie = InferenceEngine;
+
+namespace ienodejs {
+
+namespace {
+
+using detection::Detection;
+
+bool IsExecutableNetwork(const Napi::Value& value,
+                         const Napi::FunctionReference& constructor) {
+  return value.IsObject() && value.ToObject().InstanceOf(constructor.Value());
+}
+
+// Picks the image input and the FP32 output of the |stage| network, the only
+// ones unless |input| and |output| name them, and describes the input in
+// |tensor|. Returns an error message if they cannot be used.
+std::string GetStage(const ie::ExecutableNetwork& network,
+                     const std::string& stage,
+                     std::string* input,
+                     std::string* output,
+                     image::Tensor* tensor) {
+  ie::ConstInputsDataMap inputs = network.GetInputsInfo();
+  if (input->empty()) {
+    if (inputs.size() != 1) {
+      return "The " + stage + " has several inputs";
+    }
+    *input = inputs.begin()->first;
+  }
+  auto input_info = inputs.find(*input);
+  if (input_info == inputs.end()) {
+    return "The " + stage + " has no input " + *input;
+  }
+  std::string message =
+      utils::GetImageTensor(input_info->second->getTensorDesc(), tensor);
+  if (!message.empty()) {
+    return "The input of the " + stage + ": " + message;
+  }
+
+  ie::ConstOutputsDataMap outputs = network.GetOutputsInfo();
+  if (output->empty()) {
+    if (outputs.size() != 1) {
+      return "The " + stage + " has several outputs";
+    }
+    *output = outputs.begin()->first;
+  }
+  auto output_info = outputs.find(*output);
+  if (output_info == outputs.end()) {
+    return "The " + stage + " has no output " + *output;
+  }
+  if (output_info->second->getPrecision() != ie::Precision::FP32) {
+    return "The output of the " + stage + " should be FP32";
+  }
+  return std::string();
+}
+
+// The pixels of a |width| x |height| frame under |box|, which is in fractions
+// of the frame, enlarged by |padding| times the box size on every side and
+// clipped to the frame.
+image::Rect GetCrop(const Detection& box,
+                    float padding,
+                    size_t width,
+                    size_t height) {
+  const float pad_x = (box.x2 - box.x1) * padding;
+  const float pad_y = (box.y2 - box.y1) * padding;
+  auto clip = [](float value, size_t size) {
+    return std::min(std::max(value * size, 0.0f), static_cast<float>(size));
+  };
+  const size_t x1 =
+      static_cast<size_t>(std::floor(clip(box.x1 - pad_x, width)));
+  const size_t y1 =
+      static_cast<size_t>(std::floor(clip(box.y1 - pad_y, height)));
+  const size_t x2 =
+      static_cast<size_t>(std::ceil(clip(box.x2 + pad_x, width)));
+  const size_t y2 =
+      static_cast<size_t>(std::ceil(clip(box.y2 + pad_y, height)));
+  return {x1, y1, x2 > x1 ? x2 - x1 : 0, y2 > y1 ? y2 - y1 : 0};
+}
+
+ie::MemoryBlob::Ptr GetMemoryBlob(ie::InferRequest& request,
+                                  const std::string& name) {
+  ie::MemoryBlob::Ptr blob = ie::as<ie::MemoryBlob>(request.GetBlob(name));
+  if (!blob) {
+    throw std::runtime_error("Not able to cast Blob to MemoryBlob");
+  }
+  return blob;
+}
+
+}  // namespace
+
+// Detects, crops and classifies one frame on a worker thread.
+class CascadeAsyncWorker : public Napi::AsyncWorker {
+ public:
+  // |receiver| keeps the Cascade and the pixels alive while running.
+  CascadeAsyncWorker(const Napi::Object& receiver,
+                     Cascade* cascade,
+                     const Cascade::Requests& requests,
+                     const image::Frame& frame,
+                     Napi::Promise::Deferred& deferred)
+      : Napi::AsyncWorker(receiver),
+        cascade_(cascade),
+        config_(cascade->config_),
+        requests_(requests),
+        frame_(frame),
+        deferred_(deferred) {}
+
+  void Execute() {
+    try {
+      Detect();
+      Classify();
+    } catch (const std::exception& error) {
+      SetError(error.what());
+    } catch (...) {
+      SetError("Unknown/internal exception happened.");
+    }
+  }
+
+  // Resolves with the boxes, and the top classes and scores of each box.
+  void OnOK() {
+    Napi::Env env = Env();
+    cascade_->ReleaseRequests(requests_);
+    Napi::Float32Array detections = Napi::Float32Array::New(
+        env, detections_.size() * detection::kDetectionSize);
+    float* row = detections.Data();
+    for (const Detection& box : detections_) {
+      const float values[] = {box.image_id, box.label, box.confidence, box.x1,
+                              box.y1,       box.x2,    box.y2};
+      row = std::copy(values, values + detection::kDetectionSize, row);
+    }
+    Napi::Int32Array classes = Napi::Int32Array::New(env, classes_.size());
+    std::copy(classes_.begin(), classes_.end(), classes.Data());
+    Napi::Float32Array scores = Napi::Float32Array::New(env, scores_.size());
+    std::copy(scores_.begin(), scores_.end(), scores.Data());
+
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("detections", detections);
+    result.Set("classes", classes);
+    result.Set("scores", scores);
+    deferred_.Resolve(result);
+  }
+
+  void OnError(Napi::Error const& error) {
+    cascade_->ReleaseRequests(requests_);
+    deferred_.Reject(error.Value());
+  }
+
+ private:
+  // Infers the frame with the detector and keeps the boxes of the first image
+  // that have a label to classify and a crop of at least one pixel.
+  void Detect() {
+    ie::MemoryBlob::Ptr input =
+        GetMemoryBlob(requests_.detector, config_.detector_input);
+    ie::MemoryBlob::Ptr output =
+        GetMemoryBlob(requests_.detector, config_.detector_output);
+    {
+      ie::LockedMemory<void> memory = input->wmap();
+      image::Tensor tensor = config_.detector_tensor;
+      tensor.data = memory.as<void*>();
+      image::FillTensor(frame_, tensor);
+    }
+    requests_.detector.Infer();
+
+    std::vector<Detection> boxes;
+    {
+      ie::LockedMemory<const void> memory = output->rmap();
+      boxes = detection::DecodeDetectionOutput(
+          memory.as<const float*>(), output->size() / detection::kDetectionSize,
+          config_.threshold, config_.nms, config_.nms_options);
+    }
+    for (const Detection& box : boxes) {
+      if (box.image_id != 0.0f ||
+          (!config_.labels.empty() &&
+           std::find(config_.labels.begin(), config_.labels.end(),
+                     box.label) == config_.labels.end())) {
+        continue;
+      }
+      image::Rect crop =
+          GetCrop(box, config_.padding, frame_.width, frame_.height);
+      if (crop.width == 0 || crop.height == 0) {
+        continue;
+      }
+      detections_.push_back(box);
+      crops_.push_back(crop);
+    }
+  }
+
+  // Resizes the crops into the batch items of the classifier input, a batch
+  // at a time, and ranks the classes of each.
+  void Classify() {
+    if (crops_.empty()) {
+      return;
+    }
+    ie::MemoryBlob::Ptr input =
+        GetMemoryBlob(requests_.classifier, config_.classifier_input);
+    ie::MemoryBlob::Ptr output =
+        GetMemoryBlob(requests_.classifier, config_.classifier_output);
+    const size_t batch = input->getTensorDesc().getDims()[0];
+    const size_t item_byte_size = input->byteSize() / batch;
+    const size_t count = output->size() / batch;
+    if (count == 0) {
+      throw std::runtime_error("The output of the classifier is empty");
+    }
+    const size_t k = std::min<size_t>(config_.top_k, count);
+    classes_.resize(crops_.size() * k);
+    scores_.resize(crops_.size() * k);
+
+    const size_t bpp = image::GetBytesPerPixel(frame_.format);
+    for (size_t begin = 0; begin < crops_.size(); begin += batch) {
+      const size_t items = std::min(batch, crops_.size() - begin);
+      {
+        ie::LockedMemory<void> memory = input->wmap();
+        uint8_t* base = memory.as<uint8_t*>();
+        utils::ParallelFor(items, 1, [&](size_t first, size_t last) {
+          for (size_t i = first; i < last; ++i) {
+            const image::Rect& crop = crops_[begin + i];
+            // The crop is read through the row stride of the whole frame.
+            image::Frame region = frame_;
+            region.data = frame_.data + crop.y * frame_.stride + crop.x * bpp;
+            region.width = crop.width;
+            region.height = crop.height;
+            image::Tensor tensor = config_.classifier_tensor;
+            tensor.data = base + i * item_byte_size;
+            image::FillTensor(region, tensor);
+          }
+        });
+      }
+      requests_.classifier.Infer();
+
+      ie::LockedMemory<const void> memory = output->rmap();
+      const float* scores = memory.as<const float*>();
+      for (size_t i = 0; i < items; ++i) {
+        classification::TopK(scores + i * count, count, k, config_.softmax,
+                             &classes_[(begin + i) * k],
+                             &scores_[(begin + i) * k]);
+      }
+    }
+  }
+
+  Cascade* cascade_;
+  const Cascade::Config& config_;
+  Cascade::Requests requests_;
+  image::Frame frame_;
+  std::vector<Detection> detections_;
+  std::vector<image::Rect> crops_;
+  std::vector<int32_t> classes_;
+  std::vector<float> scores_;
+  Napi::Promise::Deferred deferred_;
+};
+
+Napi::FunctionReference Cascade::constructor;
+
+void Cascade::Init(const Napi::Env& env, Napi::Object exports) {
+  Napi::HandleScope scope(env);
+
+  Napi::Function func =
+      DefineClass(env, "Cascade", {InstanceMethod("run", &Cascade::Run)});
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+  exports.Set("Cascade", func);
+}
+
+Cascade::Cascade(const Napi::CallbackInfo& info)
+    : Napi::ObjectWrap<Cascade>(info) {
+  Napi::Env env = info.Env();
+  if (info.Length() < 2 || info.Length() > 3) {
+    Napi::TypeError::New(env, "Wrong number of arguments")
+        .ThrowAsJavaScriptException();
+    return;
+  }
+  if (!IsExecutableNetwork(info[0], ExecutableNetwork::constructor) ||
+      !IsExecutableNetwork(info[1], ExecutableNetwork::constructor) ||
+      (info.Length() == 3 && !info[2].IsObject())) {
+    Napi::TypeError::New(env, "Wrong type of arguments")
+        .ThrowAsJavaScriptException();
+    return;
+  }
+  ExecutableNetwork* detector =
+      Napi::ObjectWrap<ExecutableNetwork>::Unwrap(info[0].ToObject());
+  ExecutableNetwork* classifier =
+      Napi::ObjectWrap<ExecutableNetwork>::Unwrap(info[1].ToObject());
+  if (detector->disposed_ || classifier->disposed_) {
+    Napi::Error::New(env, "The ExecutableNetwork has been disposed")
+        .ThrowAsJavaScriptException();
+    return;
+  }
+  detector_ = detector->actual_;
+  classifier_ = classifier->actual_;
+
+  if (info.Length() == 3) {
+    Napi::Object options = info[2].ToObject();
+    const char* names[] = {"detectorInput", "detectorOutput",
+                           "classifierInput", "classifierOutput"};
+    std::string* fields[] = {&config_.detector_input, &config_.detector_output,
+                             &config_.classifier_input,
+                             &config_.classifier_output};
+    for (size_t i = 0; i < 4; ++i) {
+      if (!options.Has(names[i])) {
+        continue;
+      }
+      if (!options.Get(names[i]).IsString()) {
+        Napi::TypeError::New(env, std::string(names[i]) + " should be a string")
+            .ThrowAsJavaScriptException();
+        return;
+      }
+      *fields[i] = options.Get(names[i]).ToString();
+    }
+    if (options.Has("threshold")) {
+      if (!options.Get("threshold").IsNumber()) {
+        Napi::TypeError::New(env, "threshold should be a number")
+            .ThrowAsJavaScriptException();
+        return;
+      }
+      config_.threshold = options.Get("threshold").ToNumber().FloatValue();
+    }
+    if (options.Has("nms")) {
+      config_.nms = options.Get("nms").ToBoolean();
+    }
+    std::string message =
+        PostProcessing::GetNmsOptions(options, &config_.nms_options);
+    if (!message.empty()) {
+      Napi::TypeError::New(env, message).ThrowAsJavaScriptException();
+      return;
+    }
+    if (options.Has("labels")) {
+      Napi::Value labels = options.Get("labels");
+      bool valid = labels.IsArray();
+      for (uint32_t i = 0; valid && i < labels.As<Napi::Array>().Length();
+           ++i) {
+        Napi::Value label = labels.As<Napi::Array>().Get(i);
+        valid = label.IsNumber();
+        if (valid) {
+          config_.labels.push_back(label.ToNumber().FloatValue());
+        }
+      }
+      if (!valid) {
+        Napi::TypeError::New(env, "labels should be an array of numbers")
+            .ThrowAsJavaScriptException();
+        return;
+      }
+    }
+    if (options.Has("padding")) {
+      Napi::Value padding = options.Get("padding");
+      if (!padding.IsNumber() || padding.ToNumber().FloatValue() < 0) {
+        Napi::TypeError::New(env, "padding should be a number >= 0")
+            .ThrowAsJavaScriptException();
+        return;
+      }
+      config_.padding = padding.ToNumber().FloatValue();
+    }
+    if (options.Has("topK")) {
+      Napi::Value top_k = options.Get("topK");
+      if (!top_k.IsNumber() || top_k.ToNumber().Uint32Value() == 0) {
+        Napi::TypeError::New(env, "topK should be a positive number")
+            .ThrowAsJavaScriptException();
+        return;
+      }
+      config_.top_k = top_k.ToNumber().Uint32Value();
+    }
+    if (options.Has("softmax")) {
+      config_.softmax = options.Get("softmax").ToBoolean();
+    }
+  }
+
+  try {
+    std::string message =
+        GetStage(detector_, "detector", &config_.detector_input,
+                 &config_.detector_output, &config_.detector_tensor);
+    if (message.empty()) {
+      message =
+          GetStage(classifier_, "classifier", &config_.classifier_input,
+                   &config_.classifier_output, &config_.classifier_tensor);
+    }
+    if (!message.empty()) {
+      Napi::TypeError::New(env, message).ThrowAsJavaScriptException();
+      return;
+    }
+    for (const ie::ExecutableNetwork* network : {&detector_, &classifier_}) {
+      for (auto& input : network->GetInputsInfo()) {
+        requests_byte_size_ +=
+            utils::GetByteSizeOfTensorDesc(input.second->getTensorDesc());
+      }
+      for (auto& output : network->GetOutputsInfo()) {
+        requests_byte_size_ +=
+            utils::GetByteSizeOfTensorDesc(output.second->getTensorDesc());
+      }
+    }
+  } catch (const std::exception& error) {
+    Napi::Error::New(env, error.what()).ThrowAsJavaScriptException();
+  } catch (...) {
+    Napi::Error::New(env, "Unknown/internal exception happened.")
+        .ThrowAsJavaScriptException();
+  }
+}
+
+Cascade::~Cascade() {
+  if (external_memory_ > 0) {
+    Napi::MemoryManagement::AdjustExternalMemory(Env(), -external_memory_);
+  }
+}
+
+Napi::Value Cascade::Run(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+  if (info.Length() < 3 || info.Length() > 4) {
+    deferred.Reject(
+        Napi::TypeError::New(env, "Wrong number of arguments").Value());
+    return deferred.Promise();
+  }
+
+  const uint8_t* data = nullptr;
+  size_t byte_length = 0;
+  if (!utils::GetBytes(info[0], &data, &byte_length) ||
+      !info[1].IsNumber() || !info[2].IsNumber() ||
+      (info.Length() == 4 && !info[3].IsObject())) {
+    deferred.Reject(
+        Napi::TypeError::New(env, "Wrong type of arguments").Value());
+    return deferred.Promise();
+  }
+
+  image::Frame frame;
+  frame.data = data;
+  frame.width = info[1].ToNumber().Uint32Value();
+  frame.height = info[2].ToNumber().Uint32Value();
+  frame.format = image::PixelFormat::RGBA;
+  if (info.Length() == 4 && info[3].ToObject().Has("format")) {
+    Napi::Value format = info[3].ToObject().Get("format");
+    if (!format.IsString() ||
+        !image::IsPixelFormatName(format.ToString().Utf8Value())) {
+      deferred.Reject(
+          Napi::TypeError::New(env, "Unsupported pixel format").Value());
+      return deferred.Promise();
+    }
+    frame.format = image::GetPixelFormatByName(format.ToString());
+  }
+  frame.stride = frame.width * image::GetBytesPerPixel(frame.format);
+  if (frame.width == 0 || frame.height == 0) {
+    deferred.Reject(Napi::RangeError::New(env, "The image is empty").Value());
+    return deferred.Promise();
+  }
+  if (byte_length < frame.stride * frame.height) {
+    deferred.Reject(
+        Napi::RangeError::New(env, "The image data is too short").Value());
+    return deferred.Promise();
+  }
+
+  Requests requests;
+  try {
+    requests = AcquireRequests();
+  } catch (const std::exception& error) {
+    deferred.Reject(Napi::Error::New(env, error.what()).Value());
+    return deferred.Promise();
+  } catch (...) {
+    deferred.Reject(
+        Napi::Error::New(env, "Unknown/internal exception happened.").Value());
+    return deferred.Promise();
+  }
+
+  Napi::Object receiver = Napi::Object::New(env);
+  receiver.Set("cascade", info.This());
+  receiver.Set("pixels", info[0]);
+  CascadeAsyncWorker* worker =
+      new CascadeAsyncWorker(receiver, this, requests, frame, deferred);
+  worker->Queue();
+  return deferred.Promise();
+}
+
+Cascade::Requests Cascade::AcquireRequests() {
+  if (!idle_requests_.empty()) {
+    Requests requests = idle_requests_.back();
+    idle_requests_.pop_back();
+    return requests;
+  }
+  // Concurrent runs each get their own pair, which is kept for later runs.
+  Requests requests = {detector_.CreateInferRequest(),
+                       classifier_.CreateInferRequest()};
+  external_memory_ += requests_byte_size_;
+  Napi::MemoryManagement::AdjustExternalMemory(Env(), requests_byte_size_);
+  return requests;
+}
+
+void Cascade::ReleaseRequests(const Requests& requests) {
+  idle_requests_.push_back(requests);
+}
+
+}  // namespace ienodejs
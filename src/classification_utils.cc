@@ -0,0 +1,63 @@
+#include "classification_utils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+namespace ienodejs {
+
+namespace classification {
+
+namespace {
+
+typedef std::pair<float, int32_t> Entry;
+
+// Orders entries by descending score, then ascending index.
+bool Before(const Entry& a, const Entry& b) {
+  return a.first > b.first || (a.first == b.first && a.second < b.second);
+}
+
+}  // namespace
+
+void TopK(const float* scores,
+          size_t count,
+          size_t k,
+          bool softmax,
+          int32_t* indices,
+          float* values) {
+  // A heap of the best |k| so far whose top is the worst of them, so each
+  // score costs one comparison unless it enters the selection.
+  std::vector<Entry> heap;
+  heap.reserve(k);
+  for (size_t i = 0; i < count && heap.size() < k; ++i) {
+    heap.emplace_back(scores[i], static_cast<int32_t>(i));
+  }
+  std::make_heap(heap.begin(), heap.end(), Before);
+  for (size_t i = k; i < count; ++i) {
+    if (scores[i] > heap.front().first) {
+      std::pop_heap(heap.begin(), heap.end(), Before);
+      heap.back() = Entry(scores[i], static_cast<int32_t>(i));
+      std::push_heap(heap.begin(), heap.end(), Before);
+    }
+  }
+  std::sort_heap(heap.begin(), heap.end(), Before);
+
+  float max = 0.0f;
+  float sum = 1.0f;
+  if (softmax && count > 0) {
+    max = *std::max_element(scores, scores + count);
+    sum = 0.0f;
+    for (size_t i = 0; i < count; ++i) {
+      sum += std::exp(scores[i] - max);
+    }
+  }
+  for (size_t i = 0; i < heap.size(); ++i) {
+    indices[i] = heap[i].second;
+    values[i] = softmax ? std::exp(heap[i].first - max) / sum : heap[i].first;
+  }
+}
+
+}  // namespace classification
+
+}  // namespace ienodejs
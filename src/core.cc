@@ -171,6 +171,12 @@ Napi::Value Core::LoadNetwork(const Napi::CallbackInfo& info) {
     return deferred.Promise();
   }
 
+  if (Napi::ObjectWrap<Network>::Unwrap(info[0].ToObject())->disposed_) {
+    deferred.Reject(
+        Napi::Error::New(env, "The Network has been disposed").Value());
+    return deferred.Promise();
+  }
+
   ExecutableNetwork::NewInstanceAsync(env, info[0], info[1], actual_, deferred);
 
   return deferred.Promise();
@@ -0,0 +1,214 @@
+#include "detection_utils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace ienodejs {
+
+namespace detection {
+
+namespace {
+
+float GetArea(const Detection& box) {
+  return std::max(box.x2 - box.x1, 0.0f) * std::max(box.y2 - box.y1, 0.0f);
+}
+
+// Suppresses or sorts the boxes of each image, which |images| is indexed by,
+// and appends them to |result| by image.
+void AppendImages(std::vector<std::vector<Detection>>* images,
+                  bool nms,
+                  const NmsOptions& options,
+                  std::vector<Detection>* result) {
+  for (std::vector<Detection>& boxes : *images) {
+    if (nms) {
+      boxes = NonMaxSuppression(std::move(boxes), options);
+    } else {
+      std::stable_sort(boxes.begin(), boxes.end(),
+                       [](const Detection& a, const Detection& b) {
+                         return a.confidence > b.confidence;
+                       });
+      if (options.max_detections > 0 &&
+          boxes.size() > options.max_detections) {
+        boxes.resize(options.max_detections);
+      }
+    }
+    result->insert(result->end(), boxes.begin(), boxes.end());
+  }
+}
+
+float Sigmoid(float value) {
+  return 1.0f / (1.0f + std::exp(-value));
+}
+
+// No probability reaches the threshold without the objectness doing so. With
+// |sigmoid| the raw objectness is compared, against the logit of the
+// threshold.
+float GetObjectnessThreshold(const YoloOptions& options) {
+  if (!options.sigmoid) {
+    return options.threshold;
+  }
+  if (options.threshold <= 0.0f) {
+    return -INFINITY;
+  }
+  if (options.threshold >= 1.0f) {
+    return INFINITY;
+  }
+  return std::log(options.threshold / (1.0f - options.threshold));
+}
+
+}  // namespace
+
+float GetOverlap(const Detection& a, const Detection& b, OverlapMetric metric) {
+  float width = std::min(a.x2, b.x2) - std::max(a.x1, b.x1);
+  float height = std::min(a.y2, b.y2) - std::max(a.y1, b.y1);
+  if (width <= 0.0f || height <= 0.0f) {
+    return 0.0f;
+  }
+  float intersection = width * height;
+  float area_a = GetArea(a);
+  float area_b = GetArea(b);
+  float base = metric == OverlapMetric::IOS
+                   ? std::min(area_a, area_b)
+                   : area_a + area_b - intersection;
+  return base > 0.0f ? intersection / base : 0.0f;
+}
+
+std::vector<Detection> NonMaxSuppression(std::vector<Detection> detections,
+                                         const NmsOptions& options) {
+  std::stable_sort(detections.begin(), detections.end(),
+                   [](const Detection& a, const Detection& b) {
+                     return a.confidence > b.confidence;
+                   });
+  std::vector<Detection> kept;
+  for (const Detection& candidate : detections) {
+    if (options.max_detections > 0 &&
+        kept.size() == options.max_detections) {
+      break;
+    }
+    bool suppressed = false;
+    for (const Detection& box : kept) {
+      if ((options.class_agnostic || box.label == candidate.label) &&
+          GetOverlap(box, candidate, options.metric) > options.threshold) {
+        suppressed = true;
+        break;
+      }
+    }
+    if (!suppressed) {
+      kept.push_back(candidate);
+    }
+  }
+  return kept;
+}
+
+std::vector<Detection> DecodeDetectionOutput(const float* rows,
+                                             size_t count,
+                                             float threshold,
+                                             bool nms,
+                                             const NmsOptions& options) {
+  // The candidates of each image, indexed by image id.
+  std::vector<std::vector<Detection>> images;
+  for (size_t i = 0; i < count; ++i) {
+    const float* row = rows + i * kDetectionSize;
+    if (row[0] < 0.0f) {
+      break;
+    }
+    if (!(row[2] >= threshold)) {
+      continue;
+    }
+    // The output has at least a row per image of the batch, so a larger id
+    // comes from a broken tensor and must not size the images.
+    if (!(row[0] < static_cast<float>(count))) {
+      throw std::range_error("The image id " + std::to_string(row[0]) +
+                             " is out of range");
+    }
+    const size_t image_id = static_cast<size_t>(row[0]);
+    if (image_id >= images.size()) {
+      images.resize(image_id + 1);
+    }
+    images[image_id].push_back(
+        {row[0], row[1], row[2], row[3], row[4], row[5], row[6]});
+  }
+
+  std::vector<Detection> result;
+  AppendImages(&images, nms, options, &result);
+  return result;
+}
+
+std::vector<Detection> DecodeYolo(const std::vector<YoloScale>& scales,
+                                  const YoloOptions& options,
+                                  bool nms,
+                                  const NmsOptions& nms_options) {
+  const size_t entries = options.coords + 1 + options.classes;
+  const float objectness_threshold = GetObjectnessThreshold(options);
+
+  std::vector<std::vector<Detection>> images;
+  std::vector<size_t> candidates;
+  for (const YoloScale& scale : scales) {
+    const size_t area = scale.height * scale.width;
+    const size_t anchors = scale.anchors.size() / 2;
+    images.resize(std::max(images.size(), scale.batch));
+    for (size_t b = 0; b < scale.batch; ++b) {
+      for (size_t a = 0; a < anchors; ++a) {
+        const float* planes =
+            scale.data + (b * scale.channels + a * entries) * area;
+        const float* objectness = planes + options.coords * area;
+        // A branch-free pass over the objectness plane picks the cells to
+        // decode, so that the compiler can vectorize it.
+        candidates.resize(area);
+        size_t count = 0;
+        for (size_t i = 0; i < area; ++i) {
+          candidates[count] = i;
+          count += objectness[i] >= objectness_threshold;
+        }
+
+        for (size_t c = 0; c < count; ++c) {
+          const size_t i = candidates[c];
+          const float row = static_cast<float>(i / scale.width);
+          const float col = static_cast<float>(i % scale.width);
+          float x = planes[i];
+          float y = planes[area + i];
+          float score = objectness[i];
+          if (options.sigmoid) {
+            x = Sigmoid(x);
+            y = Sigmoid(y);
+            score = Sigmoid(score);
+          }
+          const float center_x = (col + x) / scale.width;
+          const float center_y = (row + y) / scale.height;
+          const float half_width = std::exp(planes[2 * area + i]) *
+                                   scale.anchors[2 * a] /
+                                   options.input_width / 2.0f;
+          const float half_height = std::exp(planes[3 * area + i]) *
+                                    scale.anchors[2 * a + 1] /
+                                    options.input_height / 2.0f;
+          const float* classes = objectness + area;
+          for (size_t k = 0; k < options.classes; ++k) {
+            float probability = classes[k * area + i];
+            if (options.sigmoid) {
+              probability = Sigmoid(probability);
+            }
+            const float confidence = score * probability;
+            if (confidence < options.threshold) {
+              continue;
+            }
+            images[b].push_back({static_cast<float>(b), static_cast<float>(k),
+                                 confidence, center_x - half_width,
+                                 center_y - half_height, center_x + half_width,
+                                 center_y + half_height});
+          }
+        }
+      }
+    }
+  }
+
+  std::vector<Detection> result;
+  AppendImages(&images, nms, nms_options, &result);
+  return result;
+}
+
+}  // namespace detection
+
+}  // namespace ienodejs
@@ -0,0 +1,316 @@
+#include "embedding_index.h"
+#include "blob.h"
+#include "float_tensor.h"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "inference_engine.hpp"
+
+using namespace Napi;
+
+namespace ie = InferenceEngine;
+
+namespace ienodejs {
+
+// Searches the gallery on a worker thread.
+class SearchAsyncWorker : public Napi::AsyncWorker {
+ public:
+  // |index| is the gallery as it was when the search started; changes made
+  // meanwhile go to a copy.
+  SearchAsyncWorker(Napi::Env& env,
+                    const std::shared_ptr<embedding::VectorIndex>& index,
+                    std::vector<float> queries,
+                    size_t k,
+                    size_t threads,
+                    Napi::Promise::Deferred& deferred)
+      : Napi::AsyncWorker(env),
+        index_(index),
+        queries_(std::move(queries)),
+        k_(k),
+        threads_(threads),
+        deferred_(deferred) {}
+
+  void Execute() {
+    try {
+      const size_t count = queries_.size() / index_->dimension();
+      ids_.resize(count * k_);
+      scores_.resize(count * k_);
+      index_->Search(queries_.data(), count, k_, threads_, ids_.data(),
+                     scores_.data());
+    } catch (const std::exception& error) {
+      SetError(error.what());
+    } catch (...) {
+      SetError("Unknown/internal exception happened.");
+    }
+  }
+
+  // Resolves with k ids and scores per query row.
+  void OnOK() {
+    Napi::Env env = Env();
+    Napi::Uint32Array ids = Napi::Uint32Array::New(env, ids_.size());
+    std::copy(ids_.begin(), ids_.end(), ids.Data());
+    Napi::Float32Array scores = Napi::Float32Array::New(env, scores_.size());
+    std::copy(scores_.begin(), scores_.end(), scores.Data());
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("ids", ids);
+    result.Set("scores", scores);
+    deferred_.Resolve(result);
+  }
+
+  void OnError(Napi::Error const& error) { deferred_.Reject(error.Value()); }
+
+ private:
+  std::shared_ptr<const embedding::VectorIndex> index_;
+  std::vector<float> queries_;
+  size_t k_;
+  size_t threads_;
+  std::vector<uint32_t> ids_;
+  std::vector<float> scores_;
+  Napi::Promise::Deferred deferred_;
+};
+
+Napi::FunctionReference EmbeddingIndex::constructor;
+
+void EmbeddingIndex::Init(const Napi::Env& env, Napi::Object exports) {
+  Napi::HandleScope scope(env);
+
+  Napi::Function func = DefineClass(
+      env, "EmbeddingIndex",
+      {InstanceMethod("add", &EmbeddingIndex::Add),
+       InstanceMethod("remove", &EmbeddingIndex::Remove),
+       InstanceMethod("search", &EmbeddingIndex::Search),
+       InstanceMethod("clear", &EmbeddingIndex::Clear),
+       InstanceAccessor("size", &EmbeddingIndex::GetSize, nullptr),
+       InstanceAccessor("dimension", &EmbeddingIndex::GetDimension,
+                        nullptr)});
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+  exports.Set("EmbeddingIndex", func);
+}
+
+EmbeddingIndex::EmbeddingIndex(const Napi::CallbackInfo& info)
+    : Napi::ObjectWrap<EmbeddingIndex>(info) {
+  Napi::Env env = info.Env();
+  if (info.Length() < 1 || info.Length() > 2) {
+    Napi::TypeError::New(env, "Wrong number of arguments")
+        .ThrowAsJavaScriptException();
+    return;
+  }
+  if (!info[0].IsNumber() || info[0].ToNumber().Uint32Value() == 0 ||
+      (info.Length() == 2 && !info[1].IsObject())) {
+    Napi::TypeError::New(env, "Wrong type of arguments")
+        .ThrowAsJavaScriptException();
+    return;
+  }
+
+  bool normalize = true;
+  bool quantize = false;
+  if (info.Length() == 2) {
+    Napi::Object options = info[1].ToObject();
+    if (options.Has("metric")) {
+      std::string metric = options.Get("metric").ToString();
+      if (metric != "cosine" && metric != "dot") {
+        Napi::TypeError::New(env, "Unsupported metric")
+            .ThrowAsJavaScriptException();
+        return;
+      }
+      normalize = metric == "cosine";
+    }
+    if (options.Has("storage")) {
+      std::string storage = options.Get("storage").ToString();
+      if (storage != "float32" && storage != "int8") {
+        Napi::TypeError::New(env, "Unsupported storage")
+            .ThrowAsJavaScriptException();
+        return;
+      }
+      quantize = storage == "int8";
+    }
+    if (options.Has("threads")) {
+      Napi::Value threads = options.Get("threads");
+      if (!threads.IsNumber() || threads.ToNumber().Uint32Value() == 0) {
+        Napi::TypeError::New(env, "threads should be a positive number")
+            .ThrowAsJavaScriptException();
+        return;
+      }
+      threads_ = threads.ToNumber().Uint32Value();
+    }
+  }
+  index_ = std::make_shared<embedding::VectorIndex>(
+      info[0].ToNumber().Uint32Value(), normalize, quantize);
+}
+
+EmbeddingIndex::~EmbeddingIndex() {
+  if (external_memory_ > 0) {
+    Napi::MemoryManagement::AdjustExternalMemory(Env(), -external_memory_);
+  }
+}
+
+void EmbeddingIndex::Add(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  if (info.Length() != 2) {
+    Napi::TypeError::New(env, "Wrong number of arguments")
+        .ThrowAsJavaScriptException();
+    return;
+  }
+  // One id, or an array of ids for the rows of the embeddings.
+  std::vector<uint32_t> ids;
+  if (info[0].IsNumber()) {
+    ids.push_back(info[0].ToNumber().Uint32Value());
+  } else if (info[0].IsArray()) {
+    Napi::Array array = info[0].As<Napi::Array>();
+    for (uint32_t i = 0; i < array.Length(); ++i) {
+      if (!array.Get(i).IsNumber()) {
+        Napi::TypeError::New(env, "The ids should be numbers")
+            .ThrowAsJavaScriptException();
+        return;
+      }
+      ids.push_back(array.Get(i).ToNumber().Uint32Value());
+    }
+  } else {
+    Napi::TypeError::New(env, "Wrong type of arguments")
+        .ThrowAsJavaScriptException();
+    return;
+  }
+
+  ie::Blob::Ptr blob;
+  if (!Blob::GetActual(env, info[1], &blob)) {
+    return;
+  }
+  FloatTensor tensor;
+  std::string message = tensor.Init(info[1], blob);
+  if (!message.empty()) {
+    Napi::TypeError::New(env, message).ThrowAsJavaScriptException();
+    return;
+  }
+  const size_t dimension = index_->dimension();
+  if (tensor.size() != ids.size() * dimension) {
+    Napi::RangeError::New(env, "Each id needs one embedding of the dimension")
+        .ThrowAsJavaScriptException();
+    return;
+  }
+  embedding::VectorIndex* index = MutableIndex();
+  for (size_t i = 0; i < ids.size(); ++i) {
+    index->Add(ids[i], tensor.data() + i * dimension);
+  }
+  UpdateExternalMemory(env);
+}
+
+Napi::Value EmbeddingIndex::Remove(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  if (info.Length() != 1) {
+    Napi::TypeError::New(env, "Wrong number of arguments")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  if (!info[0].IsNumber()) {
+    Napi::TypeError::New(env, "Wrong type of arguments")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  bool removed = MutableIndex()->Remove(info[0].ToNumber().Uint32Value());
+  UpdateExternalMemory(env);
+  return Napi::Boolean::New(env, removed);
+}
+
+Napi::Value EmbeddingIndex::Search(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+  if (info.Length() < 2 || info.Length() > 3) {
+    deferred.Reject(
+        Napi::TypeError::New(env, "Wrong number of arguments").Value());
+    return deferred.Promise();
+  }
+  if (!info[1].IsNumber() || (info.Length() == 3 && !info[2].IsObject())) {
+    deferred.Reject(
+        Napi::TypeError::New(env, "Wrong type of arguments").Value());
+    return deferred.Promise();
+  }
+  uint32_t threads = threads_;
+  if (info.Length() == 3 && info[2].ToObject().Has("threads")) {
+    Napi::Value value = info[2].ToObject().Get("threads");
+    if (!value.IsNumber() || value.ToNumber().Uint32Value() == 0) {
+      deferred.Reject(
+          Napi::TypeError::New(env, "threads should be a positive number")
+              .Value());
+      return deferred.Promise();
+    }
+    threads = value.ToNumber().Uint32Value();
+  }
+
+  ie::Blob::Ptr blob;
+  if (!Blob::GetActual(env, info[0], &blob)) {
+    // A disposed Blob rejects with the error it throws.
+    deferred.Reject(env.GetAndClearPendingException().Value());
+    return deferred.Promise();
+  }
+  FloatTensor tensor;
+  std::string message = tensor.Init(info[0], blob);
+  if (!message.empty()) {
+    deferred.Reject(Napi::TypeError::New(env, message).Value());
+    return deferred.Promise();
+  }
+  // Each row of the queries is searched on its own.
+  const size_t dimension = index_->dimension();
+  if (tensor.size() == 0 || tensor.size() % dimension != 0) {
+    deferred.Reject(
+        Napi::RangeError::New(env, "The queries are not rows of the dimension")
+            .Value());
+    return deferred.Promise();
+  }
+  const size_t k =
+      std::min<size_t>(info[1].ToNumber().Uint32Value(), index_->size());
+
+  // The queries are copied, so the caller may change them, or the Blob they
+  // are read from, before the search completes.
+  std::vector<float> queries(tensor.data(), tensor.data() + tensor.size());
+  SearchAsyncWorker* worker = new SearchAsyncWorker(
+      env, index_, std::move(queries), k, threads, deferred);
+  worker->Queue();
+  return deferred.Promise();
+}
+
+void EmbeddingIndex::Clear(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  if (info.Length() > 0) {
+    Napi::TypeError::New(env, "Invalid argument").ThrowAsJavaScriptException();
+    return;
+  }
+  if (index_.use_count() > 1) {
+    // A running search keeps the old gallery, so nothing is copied.
+    index_ = std::make_shared<embedding::VectorIndex>(
+        index_->dimension(), index_->normalize(), index_->quantize());
+  } else {
+    index_->Clear();
+  }
+  UpdateExternalMemory(env);
+}
+
+Napi::Value EmbeddingIndex::GetSize(const Napi::CallbackInfo& info) {
+  return Napi::Number::New(info.Env(), index_->size());
+}
+
+Napi::Value EmbeddingIndex::GetDimension(const Napi::CallbackInfo& info) {
+  return Napi::Number::New(info.Env(), index_->dimension());
+}
+
+embedding::VectorIndex* EmbeddingIndex::MutableIndex() {
+  if (index_.use_count() > 1) {
+    index_ = std::make_shared<embedding::VectorIndex>(*index_);
+  }
+  return index_.get();
+}
+
+void EmbeddingIndex::UpdateExternalMemory(const Napi::Env& env) {
+  const int64_t size = static_cast<int64_t>(index_->byte_size());
+  if (size != external_memory_) {
+    Napi::MemoryManagement::AdjustExternalMemory(env,
+                                                 size - external_memory_);
+    external_memory_ = size;
+  }
+}
+
+}  // namespace ienodejs
@@ -0,0 +1,258 @@
+#include "embedding_utils.h"
+#include "classification_utils.h"
+#include "parallel_for.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ienodejs {
+
+namespace embedding {
+
+namespace {
+
+// Entries scored per range at least, below which splitting costs more than it
+// saves.
+const size_t kMinEntriesPerThread = 4096;
+
+// Eight independent sums let the compiler vectorize the loop without
+// reordering a single floating point sum.
+float Dot(const float* a, const float* b, size_t size) {
+  float sums[8] = {};
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    for (size_t j = 0; j < 8; ++j) {
+      sums[j] += a[i + j] * b[i + j];
+    }
+  }
+  float sum = 0.0f;
+  for (; i < size; ++i) {
+    sum += a[i] * b[i];
+  }
+  for (size_t j = 0; j < 8; ++j) {
+    sum += sums[j];
+  }
+  return sum;
+}
+
+int32_t Dot(const int8_t* a, const int8_t* b, size_t size) {
+  int32_t sum = 0;
+  for (size_t i = 0; i < size; ++i) {
+    sum += static_cast<int32_t>(a[i]) * b[i];
+  }
+  return sum;
+}
+
+// Quantizes |vector| symmetrically to |output|. Returns the scale that
+// restores it.
+float Quantize(const float* vector, size_t size, int8_t* output) {
+  float max = 0.0f;
+  for (size_t i = 0; i < size; ++i) {
+    max = std::max(max, std::abs(vector[i]));
+  }
+  const float scale = max > 0.0f ? max / 127.0f : 1.0f;
+  for (size_t i = 0; i < size; ++i) {
+    output[i] = static_cast<int8_t>(std::lround(vector[i] / scale));
+  }
+  return scale;
+}
+
+}  // namespace
+
+VectorIndex::VectorIndex(size_t dimension, bool normalize, bool quantize)
+    : dimension_(dimension), normalize_(normalize), quantize_(quantize) {}
+
+void VectorIndex::Add(uint32_t id, const float* vector) {
+  std::vector<float> prepared(dimension_);
+  Prepare(vector, prepared.data());
+
+  size_t slot = ids_.size();
+  auto found = slots_.find(id);
+  if (found != slots_.end()) {
+    slot = found->second;
+  } else {
+    ids_.push_back(id);
+    slots_[id] = slot;
+    if (quantize_) {
+      quantized_.resize(ids_.size() * dimension_);
+      scales_.resize(ids_.size());
+    } else {
+      vectors_.resize(ids_.size() * dimension_);
+    }
+  }
+  if (quantize_) {
+    scales_[slot] = Quantize(prepared.data(), dimension_,
+                             quantized_.data() + slot * dimension_);
+  } else {
+    std::copy(prepared.begin(), prepared.end(),
+              vectors_.begin() + slot * dimension_);
+  }
+}
+
+bool VectorIndex::Remove(uint32_t id) {
+  auto found = slots_.find(id);
+  if (found == slots_.end()) {
+    return false;
+  }
+  // The last entry moves into the slot, which keeps the vectors contiguous.
+  const size_t slot = found->second;
+  const size_t last = ids_.size() - 1;
+  slots_.erase(found);
+  if (slot != last) {
+    ids_[slot] = ids_[last];
+    slots_[ids_[slot]] = slot;
+    if (quantize_) {
+      std::copy(quantized_.begin() + last * dimension_,
+                quantized_.begin() + (last + 1) * dimension_,
+                quantized_.begin() + slot * dimension_);
+      scales_[slot] = scales_[last];
+    } else {
+      std::copy(vectors_.begin() + last * dimension_,
+                vectors_.begin() + (last + 1) * dimension_,
+                vectors_.begin() + slot * dimension_);
+    }
+  }
+  ids_.pop_back();
+  if (quantize_) {
+    quantized_.resize(ids_.size() * dimension_);
+    scales_.resize(ids_.size());
+  } else {
+    vectors_.resize(ids_.size() * dimension_);
+  }
+  return true;
+}
+
+void VectorIndex::Clear() {
+  vectors_.clear();
+  quantized_.clear();
+  scales_.clear();
+  ids_.clear();
+  slots_.clear();
+}
+
+size_t VectorIndex::Search(const float* queries,
+                           size_t count,
+                           size_t k,
+                           size_t threads,
+                           uint32_t* ids,
+                           float* scores) const {
+  const size_t entries = ids_.size();
+  k = std::min(k, entries);
+  if (k == 0 || count == 0) {
+    return 0;
+  }
+  std::vector<float> prepared(count * dimension_);
+  std::vector<int8_t> quantized(quantize_ ? prepared.size() : 0);
+  std::vector<float> query_scales(count, 1.0f);
+  for (size_t q = 0; q < count; ++q) {
+    float* query = prepared.data() + q * dimension_;
+    Prepare(queries + q * dimension_, query);
+    if (quantize_) {
+      query_scales[q] =
+          Quantize(query, dimension_, quantized.data() + q * dimension_);
+    }
+  }
+
+  // Each query scores the gallery in chunks, just enough of them that fewer
+  // queries than threads still keep every thread busy. A task is one chunk
+  // of one query, and a range of tasks scores at least
+  // kMinEntriesPerThread entries.
+  threads = std::max<size_t>(1, threads);
+  const size_t chunks = std::max<size_t>(
+      1, std::min(entries / kMinEntriesPerThread,
+                  (threads + count - 1) / count));
+  const size_t chunk = (entries + chunks - 1) / chunks;
+  const size_t tasks = count * chunks;
+  const size_t grain =
+      std::max((tasks + threads - 1) / threads,
+               (kMinEntriesPerThread + chunk - 1) / chunk);
+
+  // The best k entries of each task, merged per query below.
+  std::vector<int32_t> candidate_slots(tasks * k);
+  std::vector<float> candidate_scores(tasks * k);
+  std::vector<size_t> candidate_counts(tasks);
+  utils::ParallelFor(tasks, grain, [&](size_t begin, size_t end) {
+    std::vector<float> chunk_scores(chunk);
+    for (size_t task = begin; task < end; ++task) {
+      const size_t q = task / chunks;
+      const size_t first = (task % chunks) * chunk;
+      const size_t last = std::min(entries, first + chunk);
+      Score(prepared.data() + q * dimension_,
+            quantize_ ? quantized.data() + q * dimension_ : nullptr,
+            query_scales[q], first, last, chunk_scores.data());
+      const size_t best = std::min(k, last - first);
+      int32_t* slots = candidate_slots.data() + task * k;
+      classification::TopK(chunk_scores.data(), last - first, best, false,
+                           slots, candidate_scores.data() + task * k);
+      for (size_t i = 0; i < best; ++i) {
+        slots[i] += static_cast<int32_t>(first);
+      }
+      candidate_counts[task] = best;
+    }
+  });
+
+  // The candidates of a query are in the order of the chunks, so ties still
+  // go to the lower slot.
+  std::vector<int32_t> slots(chunks * k);
+  std::vector<float> merged(chunks * k);
+  std::vector<int32_t> best(k);
+  for (size_t q = 0; q < count; ++q) {
+    size_t size = 0;
+    for (size_t task = q * chunks; task < (q + 1) * chunks; ++task) {
+      std::copy(candidate_slots.begin() + task * k,
+                candidate_slots.begin() + task * k + candidate_counts[task],
+                slots.begin() + size);
+      std::copy(candidate_scores.begin() + task * k,
+                candidate_scores.begin() + task * k + candidate_counts[task],
+                merged.begin() + size);
+      size += candidate_counts[task];
+    }
+    classification::TopK(merged.data(), size, k, false, best.data(),
+                         scores + q * k);
+    for (size_t i = 0; i < k; ++i) {
+      ids[q * k + i] = ids_[slots[best[i]]];
+    }
+  }
+  return k;
+}
+
+size_t VectorIndex::byte_size() const {
+  return vectors_.size() * sizeof(float) + quantized_.size() +
+         scales_.size() * sizeof(float);
+}
+
+void VectorIndex::Score(const float* query,
+                        const int8_t* quantized_query,
+                        float query_scale,
+                        size_t begin,
+                        size_t end,
+                        float* scores) const {
+  for (size_t i = begin; i < end; ++i) {
+    if (quantize_) {
+      scores[i - begin] =
+          Dot(quantized_query, quantized_.data() + i * dimension_,
+              dimension_) *
+          query_scale * scales_[i];
+    } else {
+      scores[i - begin] =
+          Dot(query, vectors_.data() + i * dimension_, dimension_);
+    }
+  }
+}
+
+void VectorIndex::Prepare(const float* vector, float* output) const {
+  std::copy(vector, vector + dimension_, output);
+  if (!normalize_) {
+    return;
+  }
+  const float norm = std::sqrt(Dot(output, output, dimension_));
+  if (norm > 0.0f) {
+    for (size_t i = 0; i < dimension_; ++i) {
+      output[i] /= norm;
+    }
+  }
+}
+
+}  // namespace embedding
+
+}  // namespace ienodejs
@@ -2,6 +2,7 @@
 
 #include "infer_request.h"
 #include "network.h"
+#include "utils.h"
 
 #include <napi.h>
 
@@ -22,7 +23,9 @@ class LoadNetworkAsyncWorker : public Napi::AsyncWorker {
         device_name_(device_name.As<Napi::String>()),
         env_(env),
         deferred_(deferred) {
-    network_ = Napi::ObjectWrap<Network>::Unwrap(network.ToObject())->actual_;
+    Network* js_network = Napi::ObjectWrap<Network>::Unwrap(network.ToObject());
+    network_ = js_network->actual_;
+    weights_byte_size_ = js_network->weights_byte_size_;
   }
 
   ~LoadNetworkAsyncWorker() override = default;
@@ -45,6 +48,8 @@ class LoadNetworkAsyncWorker : public Napi::AsyncWorker {
     ExecutableNetwork* exec_network =
         Napi::ObjectWrap<ExecutableNetwork>::Unwrap(obj);
     exec_network->actual_ = executable_network_;
+    exec_network->external_memory_ = weights_byte_size_;
+    Napi::MemoryManagement::AdjustExternalMemory(env_, weights_byte_size_);
     deferred_.Resolve(scope.Escape(napi_value(obj)).ToObject());
   }
 
@@ -56,6 +61,7 @@ class LoadNetworkAsyncWorker : public Napi::AsyncWorker {
   ie::CNNNetwork network_;
   ie::Core core_;
   ie::ExecutableNetwork executable_network_;
+  int64_t weights_byte_size_;
   std::string device_name_;
   Napi::Env env_;
   Napi::Promise::Deferred deferred_;
@@ -66,10 +72,14 @@ Napi::FunctionReference ExecutableNetwork::constructor;
 void ExecutableNetwork::Init(const Napi::Env& env) {
   Napi::HandleScope scope(env);
 
-  Napi::Function func =
-      DefineClass(env, "ExecutableNetwork",
-                  {InstanceMethod("createInferRequest",
-                                  &ExecutableNetwork::CreateInferRequest)});
+  Napi::Function func = DefineClass(
+      env, "ExecutableNetwork",
+      {InstanceMethod("createInferRequest",
+                      &ExecutableNetwork::CreateInferRequest),
+       InstanceMethod("enableBlobArena", &ExecutableNetwork::EnableBlobArena),
+       InstanceMethod("getBlobArenaStats",
+                      &ExecutableNetwork::GetBlobArenaStats),
+       InstanceMethod("dispose", &ExecutableNetwork::Dispose)});
 
   constructor = Napi::Persistent(func);
   constructor.SuppressDestruct();
@@ -78,6 +88,12 @@ void ExecutableNetwork::Init(const Napi::Env& env) {
 ExecutableNetwork::ExecutableNetwork(const Napi::CallbackInfo& info)
     : Napi::ObjectWrap<ExecutableNetwork>(info) {}
 
+ExecutableNetwork::~ExecutableNetwork() {
+  if (external_memory_ > 0) {
+    Napi::MemoryManagement::AdjustExternalMemory(Env(), -external_memory_);
+  }
+}
+
 void ExecutableNetwork::NewInstanceAsync(Napi::Env& env,
                                          const Napi::Value& network,
                                          const Napi::Value& dev_name,
@@ -91,13 +107,30 @@ void ExecutableNetwork::NewInstanceAsync(Napi::Env& env,
 Napi::Value ExecutableNetwork::CreateInferRequest(
     const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
+  if (CheckDisposed(env)) {
+    return env.Null();
+  }
   if (info.Length() > 0) {
     Napi::TypeError::New(env, "Invalid argument").ThrowAsJavaScriptException();
     return Napi::Object::New(env);
   }
   try {
     ie::InferRequest infer_request = actual_.CreateInferRequest();
-    return InferRequest::NewInstance(env, infer_request);
+    int64_t byte_size = 0;
+    for (auto& input : actual_.GetInputsInfo()) {
+      byte_size +=
+          utils::GetByteSizeOfTensorDesc(input.second->getTensorDesc());
+    }
+    std::vector<std::string> output_names;
+    for (auto& output : actual_.GetOutputsInfo()) {
+      output_names.push_back(output.first);
+      byte_size +=
+          utils::GetByteSizeOfTensorDesc(output.second->getTensorDesc());
+    }
+    // With an arena the request frees its own blobs and uses the arena's,
+    // which the arena reports.
+    return InferRequest::NewInstance(env, infer_request, arena_, output_names,
+                                     arena_ ? 0 : byte_size);
   } catch (const std::exception& error) {
     Napi::RangeError::New(env, error.what()).ThrowAsJavaScriptException();
     return env.Null();
@@ -108,4 +141,98 @@ Napi::Value ExecutableNetwork::CreateInferRequest(
   }
 }
 
-}  // namespace ienodejs
\ No newline at end of file
+void ExecutableNetwork::EnableBlobArena(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  if (CheckDisposed(env)) {
+    return;
+  }
+
+  if (info.Length() != 1) {
+    Napi::TypeError::New(env, "Wrong number of arguments")
+        .ThrowAsJavaScriptException();
+    return;
+  }
+
+  if (!info[0].IsNumber()) {
+    Napi::TypeError::New(env, "Wrong type of arguments")
+        .ThrowAsJavaScriptException();
+    return;
+  }
+
+  int64_t capacity = info[0].ToNumber().Int64Value();
+  if (capacity < 1) {
+    Napi::RangeError::New(env, "The capacity should be greater than 0")
+        .ThrowAsJavaScriptException();
+    return;
+  }
+
+  if (arena_) {
+    Napi::Error::New(env, "Blob arena is already enabled")
+        .ThrowAsJavaScriptException();
+    return;
+  }
+
+  try {
+    arena_ = std::make_shared<BlobArena>(env, actual_, capacity);
+  } catch (const std::exception& error) {
+    Napi::Error::New(env, error.what()).ThrowAsJavaScriptException();
+  } catch (...) {
+    Napi::Error::New(env, "Unknown/internal exception happened.")
+        .ThrowAsJavaScriptException();
+  }
+}
+
+Napi::Value ExecutableNetwork::GetBlobArenaStats(
+    const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  if (CheckDisposed(env)) {
+    return env.Null();
+  }
+  if (info.Length() > 0) {
+    Napi::TypeError::New(env, "Invalid argument").ThrowAsJavaScriptException();
+    return Napi::Object::New(env);
+  }
+
+  if (!arena_) {
+    return env.Null();
+  }
+
+  BlobArena::Stats stats = arena_->GetStats();
+  Napi::Object js_stats = Napi::Object::New(env);
+  js_stats.Set("capacity", stats.capacity);
+  js_stats.Set("allocated", stats.allocated);
+  js_stats.Set("inUse", stats.in_use);
+  js_stats.Set("peakInUse", stats.peak_in_use);
+  js_stats.Set("averageInUse", stats.average_in_use);
+  js_stats.Set("leases", stats.leases);
+  js_stats.Set("exhausted", stats.exhausted);
+  js_stats.Set("setByteSize", stats.set_byte_size);
+  return js_stats;
+}
+
+void ExecutableNetwork::Dispose(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  if (info.Length() > 0) {
+    Napi::TypeError::New(env, "Invalid argument").ThrowAsJavaScriptException();
+    return;
+  }
+
+  // Infer requests already created keep the plugin objects they use alive.
+  actual_ = ie::ExecutableNetwork();
+  arena_.reset();
+  disposed_ = true;
+  if (external_memory_ > 0) {
+    Napi::MemoryManagement::AdjustExternalMemory(env, -external_memory_);
+    external_memory_ = 0;
+  }
+}
+
+bool ExecutableNetwork::CheckDisposed(const Napi::Env& env) {
+  if (disposed_) {
+    Napi::Error::New(env, "The ExecutableNetwork has been disposed")
+        .ThrowAsJavaScriptException();
+  }
+  return disposed_;
+}
+
+}  // namespace ienodejs
@@ -0,0 +1,99 @@
+#include "float_tensor.h"
+#include "fp16.h"
+#include "utils.h"
+
+#include <stdexcept>
+
+namespace ie = InferenceEngine;
+
+namespace ienodejs {
+
+namespace {
+
+bool IsFloat32Array(const Napi::Value& value) {
+  return value.IsTypedArray() &&
+         value.As<Napi::TypedArray>().TypedArrayType() == napi_float32_array;
+}
+
+}  // namespace
+
+std::string FloatTensor::Init(const Napi::Value& value,
+                              const ie::Blob::Ptr& blob) {
+  if (blob) {
+    try {
+      return Map(blob);
+    } catch (const std::exception& error) {
+      return error.what();
+    } catch (...) {
+      return "Unknown/internal exception happened.";
+    }
+  }
+  if (value.IsObject() && !value.IsTypedArray()) {
+    return Read(value.ToObject());
+  }
+  if (!IsFloat32Array(value)) {
+    return "Wrong type of arguments";
+  }
+  Napi::Float32Array array = value.As<Napi::Float32Array>();
+  data_ = static_cast<const float*>(utils::GetTypedArrayData(array));
+  dims_ = {1, array.ElementLength()};
+  return std::string();
+}
+
+size_t FloatTensor::size() const {
+  size_t size = 1;
+  for (size_t dim : dims_) {
+    size *= dim;
+  }
+  return size;
+}
+
+std::string FloatTensor::Map(const ie::Blob::Ptr& blob) {
+  const ie::TensorDesc& desc = blob->getTensorDesc();
+  blob_ = ie::as<ie::MemoryBlob>(blob);
+  if (!blob_) {
+    return "Not able to cast Blob to MemoryBlob";
+  }
+  const ie::Precision& precision = desc.getPrecision();
+  if (precision != ie::Precision::FP32 && precision != ie::Precision::FP16) {
+    return "Only FP32 and FP16 Blobs can be read";
+  }
+  dims_ = desc.getDims();
+  memory_.reset(new ie::LockedMemory<const void>(blob_->rmap()));
+  if (precision == ie::Precision::FP32) {
+    data_ = memory_->as<const float*>();
+  } else {
+    const uint16_t* half = memory_->as<const uint16_t*>();
+    converted_.resize(blob_->size());
+    for (size_t i = 0; i < converted_.size(); ++i) {
+      converted_[i] = utils::HalfToFloat(half[i]);
+    }
+    data_ = converted_.data();
+  }
+  return std::string();
+}
+
+std::string FloatTensor::Read(const Napi::Object& object) {
+  Napi::Value data = object.Get("data");
+  Napi::Value dims = object.Get("dims");
+  if (!IsFloat32Array(data) || !dims.IsArray()) {
+    return "A tensor should have a Float32Array data and an array of dims";
+  }
+  Napi::Float32Array array = data.As<Napi::Float32Array>();
+  Napi::Array dim_array = dims.As<Napi::Array>();
+  dims_.clear();
+  for (uint32_t i = 0; i < dim_array.Length(); ++i) {
+    Napi::Value dim = dim_array.Get(i);
+    if (!dim.IsNumber() || dim.ToNumber().DoubleValue() < 0) {
+      return "The dims should be non-negative numbers";
+    }
+    dims_.push_back(dim.ToNumber().Uint32Value());
+  }
+  if (dims_.empty() || size() != array.ElementLength()) {
+    return "The dims do not match the length of the data";
+  }
+  data_ = static_cast<const float*>(utils::GetTypedArrayData(array));
+  return std::string();
+}
+
+}  // namespace ienodejs
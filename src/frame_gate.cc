@@ -0,0 +1,204 @@
+#include "frame_gate.h"
+#include "image_utils.h"
+#include "utils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+using namespace Napi;
+
+namespace ienodejs {
+
+Napi::FunctionReference FrameGate::constructor;
+
+void FrameGate::Init(const Napi::Env& env, Napi::Object exports) {
+  Napi::HandleScope scope(env);
+
+  Napi::Function func = DefineClass(
+      env, "FrameGate",
+      {InstanceMethod("check", &FrameGate::Check),
+       InstanceMethod("getStats", &FrameGate::GetStats),
+       InstanceMethod("reset", &FrameGate::Reset),
+       InstanceAccessor("threshold", &FrameGate::GetThreshold,
+                        &FrameGate::SetThreshold)});
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+  exports.Set("FrameGate", func);
+}
+
+FrameGate::FrameGate(const Napi::CallbackInfo& info)
+    : Napi::ObjectWrap<FrameGate>(info) {
+  Napi::Env env = info.Env();
+  if (info.Length() > 1 || (info.Length() == 1 && !info[0].IsObject())) {
+    Napi::TypeError::New(env, "Wrong type of arguments")
+        .ThrowAsJavaScriptException();
+    return;
+  }
+  if (info.Length() == 0) {
+    return;
+  }
+
+  Napi::Object options = info[0].ToObject();
+  if (options.Has("threshold")) {
+    SetThreshold(info, options.Get("threshold"));
+    if (env.IsExceptionPending()) {
+      return;
+    }
+  }
+  if (options.Has("gridSize")) {
+    Napi::Value value = options.Get("gridSize");
+    if (!value.IsNumber() || value.ToNumber().Uint32Value() == 0) {
+      Napi::TypeError::New(env, "gridSize should be a positive number")
+          .ThrowAsJavaScriptException();
+      return;
+    }
+    grid_size_ = value.ToNumber().Uint32Value();
+  }
+  if (options.Has("maxSkips")) {
+    if (!options.Get("maxSkips").IsNumber()) {
+      Napi::TypeError::New(env, "maxSkips should be a number")
+          .ThrowAsJavaScriptException();
+      return;
+    }
+    max_skips_ = options.Get("maxSkips").ToNumber().Uint32Value();
+  }
+  if (options.Has("metric")) {
+    std::string metric = options.Get("metric").ToString();
+    if (metric != "mean" && metric != "max") {
+      Napi::TypeError::New(env, "Unsupported metric")
+          .ThrowAsJavaScriptException();
+      return;
+    }
+    use_max_ = metric == "max";
+  }
+}
+
+Napi::Value FrameGate::Check(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  if (info.Length() < 3 || info.Length() > 4) {
+    Napi::TypeError::New(env, "Wrong number of arguments")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  const uint8_t* data = nullptr;
+  size_t byte_length = 0;
+  if (!utils::GetBytes(info[0], &data, &byte_length) ||
+      !info[1].IsNumber() || !info[2].IsNumber() ||
+      (info.Length() == 4 && !info[3].IsObject())) {
+    Napi::TypeError::New(env, "Wrong type of arguments")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  image::Frame frame;
+  frame.data = data;
+  frame.width = info[1].ToNumber().Uint32Value();
+  frame.height = info[2].ToNumber().Uint32Value();
+  frame.format = image::PixelFormat::RGBA;
+  if (info.Length() == 4 && info[3].ToObject().Has("format")) {
+    Napi::Value format = info[3].ToObject().Get("format");
+    if (!format.IsString() ||
+        !image::IsPixelFormatName(format.ToString().Utf8Value())) {
+      Napi::TypeError::New(env, "Unsupported pixel format")
+          .ThrowAsJavaScriptException();
+      return env.Null();
+    }
+    frame.format = image::GetPixelFormatByName(format.ToString());
+  }
+  frame.stride = frame.width * image::GetBytesPerPixel(frame.format);
+  if (frame.width == 0 || frame.height == 0) {
+    Napi::RangeError::New(env, "The image is empty")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  if (byte_length < frame.stride * frame.height) {
+    Napi::RangeError::New(env, "The image data is too short")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  // The grid keeps the aspect ratio of the frame and is never finer than it.
+  const size_t grid_width = std::min(grid_size_, frame.width);
+  const size_t grid_height = std::max<size_t>(
+      1, std::min<size_t>(frame.height,
+                          std::lround(static_cast<double>(grid_width) *
+                                      frame.height / frame.width)));
+  std::vector<float> grid;
+  image::GetLumaGrid(frame, grid_width, grid_height, &grid);
+
+  ++frames_;
+  bool changed = true;
+  if (reference_.size() == grid.size() && width_ == frame.width &&
+      height_ == frame.height) {
+    double sum = 0.0;
+    double max = 0.0;
+    for (size_t i = 0; i < grid.size(); ++i) {
+      double difference = std::abs(grid[i] - reference_[i]);
+      sum += difference;
+      max = std::max(max, difference);
+    }
+    last_difference_ = use_max_ ? max : sum / grid.size();
+    changed = last_difference_ > threshold_ ||
+              (max_skips_ > 0 && consecutive_skips_ >= max_skips_);
+  } else {
+    last_difference_ = 1.0;
+  }
+
+  if (changed) {
+    // Later frames are compared with this one, which is about to be inferred.
+    reference_.swap(grid);
+    width_ = frame.width;
+    height_ = frame.height;
+    consecutive_skips_ = 0;
+  } else {
+    ++skipped_;
+    ++consecutive_skips_;
+  }
+  return Napi::Boolean::New(env, changed);
+}
+
+Napi::Value FrameGate::GetStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  if (info.Length() > 0) {
+    Napi::TypeError::New(env, "Invalid argument").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  Napi::Object stats = Napi::Object::New(env);
+  stats.Set("frames", static_cast<double>(frames_));
+  stats.Set("inferred", static_cast<double>(frames_ - skipped_));
+  stats.Set("skipped", static_cast<double>(skipped_));
+  stats.Set("skipRate",
+            frames_ > 0 ? static_cast<double>(skipped_) / frames_ : 0.0);
+  stats.Set("lastDifference", last_difference_);
+  return stats;
+}
+
+void FrameGate::Reset(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  if (info.Length() > 0) {
+    Napi::TypeError::New(env, "Invalid argument").ThrowAsJavaScriptException();
+    return;
+  }
+  // The next frame is inferred; the counters are kept.
+  reference_.clear();
+  consecutive_skips_ = 0;
+}
+
+Napi::Value FrameGate::GetThreshold(const Napi::CallbackInfo& info) {
+  return Napi::Number::New(info.Env(), threshold_);
+}
+
+void FrameGate::SetThreshold(const Napi::CallbackInfo& info,
+                             const Napi::Value& value) {
+  if (!value.IsNumber() || value.ToNumber().FloatValue() < 0) {
+    Napi::TypeError::New(info.Env(), "threshold should be a number >= 0")
+        .ThrowAsJavaScriptException();
+    return;
+  }
+  threshold_ = value.ToNumber().FloatValue();
+}
+
+}  // namespace ienodejs
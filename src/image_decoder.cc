@@ -0,0 +1,173 @@
+#include "image_decoder.h"
+
+#include <csetjmp>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#ifdef IE_NODE_WITH_JPEG
+#include <jpeglib.h>
+#endif
+#ifdef IE_NODE_WITH_PNG
+#include <png.h>
+#endif
+
+namespace ienodejs {
+
+namespace image {
+
+namespace {
+
+void CheckImageSize(size_t width, size_t height) {
+  if (width * height > kMaxImagePixels) {
+    throw std::range_error("The image of " + std::to_string(width) + "x" +
+                           std::to_string(height) + " pixels is too large");
+  }
+}
+
+#ifdef IE_NODE_WITH_JPEG
+struct JPEGErrorManager {
+  jpeg_error_mgr manager;
+  jmp_buf jump;
+  char message[JMSG_LENGTH_MAX];
+};
+
+// libjpeg exits the process on errors by default.
+void ExitJPEGError(j_common_ptr info) {
+  JPEGErrorManager* error = reinterpret_cast<JPEGErrorManager*>(info->err);
+  info->err->format_message(info, error->message);
+  longjmp(error->jump, 1);
+}
+
+// Warnings, e.g. about truncated files that still decode, go to stderr.
+void IgnoreJPEGMessage(j_common_ptr) {}
+
+void DecodeJPEG(const uint8_t* data,
+                size_t size,
+                size_t min_width,
+                size_t min_height,
+                DecodedImage* image) {
+  jpeg_decompress_struct info;
+  JPEGErrorManager error;
+  info.err = jpeg_std_error(&error.manager);
+  error.manager.error_exit = ExitJPEGError;
+  error.manager.output_message = IgnoreJPEGMessage;
+  if (setjmp(error.jump)) {
+    jpeg_destroy_decompress(&info);
+    throw std::runtime_error(std::string("Failed to decode JPEG: ") +
+                             error.message);
+  }
+
+  jpeg_create_decompress(&info);
+  jpeg_mem_src(&info, const_cast<unsigned char*>(data),
+               static_cast<unsigned long>(size));
+  jpeg_read_header(&info, TRUE);
+  try {
+    CheckImageSize(info.image_width, info.image_height);
+  } catch (...) {
+    jpeg_destroy_decompress(&info);
+    throw;
+  }
+  info.out_color_space = JCS_RGB;
+
+  // Pick the largest of the 1/2, 1/4 and 1/8 DCT scales that still covers the
+  // requested size; decoding fewer coefficients is much cheaper than resizing.
+  info.scale_num = 1;
+  info.scale_denom = 1;
+  for (unsigned int denom = 8; denom > 1; denom /= 2) {
+    if (min_width > 0 && min_height > 0 &&
+        (info.image_width + denom - 1) / denom >= min_width &&
+        (info.image_height + denom - 1) / denom >= min_height) {
+      info.scale_denom = denom;
+      break;
+    }
+  }
+
+  jpeg_start_decompress(&info);
+  image->width = info.output_width;
+  image->height = info.output_height;
+  image->source_width = info.image_width;
+  image->source_height = info.image_height;
+  image->pixels.resize(image->width * image->height * 3);
+  const size_t stride = image->width * 3;
+  while (info.output_scanline < info.output_height) {
+    JSAMPROW row = image->pixels.data() + info.output_scanline * stride;
+    jpeg_read_scanlines(&info, &row, 1);
+  }
+  jpeg_finish_decompress(&info);
+  jpeg_destroy_decompress(&info);
+}
+#endif
+
+#ifdef IE_NODE_WITH_PNG
+void DecodePNG(const uint8_t* data, size_t size, DecodedImage* image) {
+  png_image png;
+  memset(&png, 0, sizeof(png));
+  png.version = PNG_IMAGE_VERSION;
+  if (!png_image_begin_read_from_memory(&png, data, size)) {
+    throw std::runtime_error(std::string("Failed to decode PNG: ") +
+                             png.message);
+  }
+  try {
+    CheckImageSize(png.width, png.height);
+  } catch (...) {
+    png_image_free(&png);
+    throw;
+  }
+  // Transparent pixels are composited onto black.
+  png.format = PNG_FORMAT_RGB;
+  image->width = png.width;
+  image->height = png.height;
+  image->source_width = png.width;
+  image->source_height = png.height;
+  image->pixels.resize(PNG_IMAGE_SIZE(png));
+  if (!png_image_finish_read(&png, nullptr, image->pixels.data(), 0,
+                             nullptr)) {
+    std::string message = png.message;
+    png_image_free(&png);
+    throw std::runtime_error("Failed to decode PNG: " + message);
+  }
+}
+#endif
+
+}  // namespace
+
+bool IsJPEG(const uint8_t* data, size_t size) {
+  return size >= 3 && data[0] == 0xff && data[1] == 0xd8 && data[2] == 0xff;
+}
+
+bool IsPNG(const uint8_t* data, size_t size) {
+  static const uint8_t kSignature[] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a,
+                                       '\n'};
+  return size >= sizeof(kSignature) &&
+         memcmp(data, kSignature, sizeof(kSignature)) == 0;
+}
+
+void DecodeImage(const uint8_t* data,
+                 size_t size,
+                 size_t min_width,
+                 size_t min_height,
+                 DecodedImage* image) {
+  if (IsJPEG(data, size)) {
+#ifdef IE_NODE_WITH_JPEG
+    DecodeJPEG(data, size, min_width, min_height, image);
+    return;
+#else
+    throw std::runtime_error("JPEG decoding is not built in");
+#endif
+  }
+  if (IsPNG(data, size)) {
+#ifdef IE_NODE_WITH_PNG
+    DecodePNG(data, size, image);
+    return;
+#else
+    throw std::runtime_error("PNG decoding is not built in");
+#endif
+  }
+  throw std::runtime_error("Only JPEG and PNG images can be decoded");
+}
+
+}  // namespace image
+
+}  // namespace ienodejs
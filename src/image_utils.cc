@@ -0,0 +1,326 @@
+#include "image_utils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "fp16.h"
+#include "parallel_for.h"
+
+namespace ienodejs {
+
+namespace image {
+
+namespace {
+
+// Below this many pixels the cost of starting threads outweighs the work.
+const size_t kPixelsPerThread = 1 << 17;
+
+template <typename T>
+inline T Convert(float value);
+
+template <>
+inline float Convert<float>(float value) {
+  return value;
+}
+
+template <>
+inline uint16_t Convert<uint16_t>(float value) {
+  return utils::FloatToHalf(value);
+}
+
+template <>
+inline uint8_t Convert<uint8_t>(float value) {
+  return static_cast<uint8_t>(std::min(std::max(value + 0.5f, 0.0f), 255.0f));
+}
+
+// Bilinear taps along one axis, aligning the pixel centers of |src_size|
+// source samples with those of |dst_size| destination samples.
+struct Taps {
+  std::vector<size_t> first;
+  std::vector<size_t> second;
+  std::vector<float> weight;
+};
+
+void ComputeTaps(size_t src_size, size_t dst_size, size_t stride, Taps* taps) {
+  taps->first.resize(dst_size);
+  taps->second.resize(dst_size);
+  taps->weight.resize(dst_size);
+  const float ratio = static_cast<float>(src_size) / dst_size;
+  for (size_t i = 0; i < dst_size; ++i) {
+    float position = std::max((i + 0.5f) * ratio - 0.5f, 0.0f);
+    size_t first = std::min(static_cast<size_t>(position), src_size - 1);
+    size_t second = std::min(first + 1, src_size - 1);
+    taps->first[i] = first * stride;
+    taps->second[i] = second * stride;
+    taps->weight[i] = std::min(position - first, 1.0f);
+  }
+}
+
+// Reads pixels of a frame that has the size of the tensor.
+class DirectSampler {
+ public:
+  DirectSampler(const Frame& frame, size_t y)
+      : row_(frame.data + y * frame.stride),
+        bpp_(GetBytesPerPixel(frame.format)) {}
+
+  float operator()(size_t x, size_t channel) const {
+    return row_[x * bpp_ + channel];
+  }
+
+ private:
+  const uint8_t* row_;
+  size_t bpp_;
+};
+
+// Interpolates pixels of a frame of any size.
+class BilinearSampler {
+ public:
+  BilinearSampler(const Frame& frame, const Taps& xs, const Taps& ys, size_t y)
+      : top_(frame.data + ys.first[y]),
+        bottom_(frame.data + ys.second[y]),
+        weight_(ys.weight[y]),
+        xs_(xs) {}
+
+  float operator()(size_t x, size_t channel) const {
+    const size_t left = xs_.first[x] + channel;
+    const size_t right = xs_.second[x] + channel;
+    const float wx = xs_.weight[x];
+    float top = top_[left] + (top_[right] - top_[left]) * wx;
+    float bottom = bottom_[left] + (bottom_[right] - bottom_[left]) * wx;
+    return top + (bottom - top) * weight_;
+  }
+
+ private:
+  const uint8_t* top_;
+  const uint8_t* bottom_;
+  float weight_;
+  const Taps& xs_;
+};
+
+// Produces the padding around the target rect.
+class PadSampler {
+ public:
+  explicit PadSampler(float value) : value_(value) {}
+
+  float operator()(size_t, size_t) const { return value_; }
+
+ private:
+  float value_;
+};
+
+// Per-row conversion shared by all samplers: picks the source channel of each
+// destination channel and folds the normalization into a multiply-add.
+template <typename T>
+class RowWriter {
+ public:
+  RowWriter(const Frame& frame, const Tensor& tensor) : tensor_(tensor) {
+    const bool frame_bgr =
+        frame.format == PixelFormat::BGRA || frame.format == PixelFormat::BGR;
+    for (size_t k = 0; k < 3; ++k) {
+      index_[k] = tensor.bgr == frame_bgr ? k : 2 - k;
+      scale_[k] = 1.0f / tensor.std[k];
+      offset_[k] = -tensor.mean[k] * scale_[k];
+    }
+  }
+
+  // Writes |count| sampled pixels of row |y|, starting at column |begin|.
+  template <typename Sampler>
+  void Write(const Sampler& sample,
+             size_t y,
+             size_t begin,
+             size_t count) const {
+    T* dst = static_cast<T*>(tensor_.data);
+    if (tensor_.planar) {
+      const size_t plane = tensor_.width * tensor_.height;
+      for (size_t k = 0; k < 3; ++k) {
+        T* out = dst + k * plane + y * tensor_.width + begin;
+        const size_t index = index_[k];
+        const float s = scale_[k];
+        const float o = offset_[k];
+        for (size_t x = 0; x < count; ++x) {
+          out[x] = Convert<T>(sample(x, index) * s + o);
+        }
+      }
+    } else {
+      T* out = dst + (y * tensor_.width + begin) * 3;
+      for (size_t x = 0; x < count; ++x) {
+        for (size_t k = 0; k < 3; ++k) {
+          out[x * 3 + k] = Convert<T>(sample(x, index_[k]) * scale_[k] +
+                                      offset_[k]);
+        }
+      }
+    }
+  }
+
+  void WritePad(size_t y, size_t begin, size_t count) const {
+    Write(PadSampler(tensor_.pad), y, begin, count);
+  }
+
+ private:
+  const Tensor& tensor_;
+  size_t index_[3];
+  float scale_[3];
+  float offset_[3];
+};
+
+// Fills rows [begin, end) of the tensor, sampling the target rect through the
+// sampler that |make_sampler| returns for each of its rows.
+template <typename T, typename MakeSampler>
+void FillRows(const RowWriter<T>& writer,
+              const Tensor& tensor,
+              const MakeSampler& make_sampler,
+              size_t begin,
+              size_t end) {
+  const Rect& target = tensor.target;
+  const size_t right = target.x + target.width;
+  for (size_t y = begin; y < end; ++y) {
+    if (y < target.y || y >= target.y + target.height) {
+      writer.WritePad(y, 0, tensor.width);
+      continue;
+    }
+    writer.WritePad(y, 0, target.x);
+    writer.Write(make_sampler(y - target.y), y, target.x, target.width);
+    writer.WritePad(y, right, tensor.width - right);
+  }
+}
+
+template <typename T>
+void Fill(const Frame& frame, const Tensor& tensor) {
+  RowWriter<T> writer(frame, tensor);
+  size_t grain = std::max<size_t>(1, kPixelsPerThread / tensor.width);
+  const Rect& target = tensor.target;
+
+  if (frame.width == target.width && frame.height == target.height) {
+    auto make_sampler = [&](size_t y) { return DirectSampler(frame, y); };
+    utils::ParallelFor(tensor.height, grain, [&](size_t begin, size_t end) {
+      FillRows(writer, tensor, make_sampler, begin, end);
+    });
+    return;
+  }
+
+  const size_t bpp = GetBytesPerPixel(frame.format);
+  Taps xs;
+  Taps ys;
+  ComputeTaps(frame.width, target.width, bpp, &xs);
+  ComputeTaps(frame.height, target.height, frame.stride, &ys);
+  auto make_sampler = [&](size_t y) {
+    return BilinearSampler(frame, xs, ys, y);
+  };
+  utils::ParallelFor(tensor.height, grain, [&](size_t begin, size_t end) {
+    FillRows(writer, tensor, make_sampler, begin, end);
+  });
+}
+
+}  // namespace
+
+bool IsPixelFormatName(const std::string& name) {
+  return name == "rgba" || name == "bgra" || name == "rgb" || name == "bgr";
+}
+
+PixelFormat GetPixelFormatByName(const std::string& name) {
+  if (name == "rgba") {
+    return PixelFormat::RGBA;
+  } else if (name == "bgra") {
+    return PixelFormat::BGRA;
+  } else if (name == "rgb") {
+    return PixelFormat::RGB;
+  } else if (name == "bgr") {
+    return PixelFormat::BGR;
+  }
+  throw std::invalid_argument("Unsupported pixel format " + name);
+}
+
+size_t GetBytesPerPixel(const PixelFormat& format) {
+  return format == PixelFormat::RGBA || format == PixelFormat::BGRA ? 4 : 3;
+}
+
+Rect GetLetterboxRect(size_t width,
+                      size_t height,
+                      size_t tensor_width,
+                      size_t tensor_height) {
+  double scale = std::min(static_cast<double>(tensor_width) / width,
+                          static_cast<double>(tensor_height) / height);
+  Rect rect;
+  rect.width = std::max<size_t>(
+      1, std::min<size_t>(tensor_width, std::lround(width * scale)));
+  rect.height = std::max<size_t>(
+      1, std::min<size_t>(tensor_height, std::lround(height * scale)));
+  rect.x = (tensor_width - rect.width) / 2;
+  rect.y = (tensor_height - rect.height) / 2;
+  return rect;
+}
+
+Transform GetTransform(const Rect& target, size_t width, size_t height) {
+  Transform transform;
+  transform.scale_x = static_cast<double>(target.width) / width;
+  transform.scale_y = static_cast<double>(target.height) / height;
+  transform.pad_x = target.x;
+  transform.pad_y = target.y;
+  return transform;
+}
+
+void FillTensor(const Frame& frame, const Tensor& tensor) {
+  const Rect& target = tensor.target;
+  if (frame.width == 0 || frame.height == 0 || target.width == 0 ||
+      target.height == 0 || target.x + target.width > tensor.width ||
+      target.y + target.height > tensor.height) {
+    throw std::invalid_argument("The frame or target rect is empty");
+  }
+  switch (tensor.type) {
+    case ElementType::U8:
+      Fill<uint8_t>(frame, tensor);
+      break;
+    case ElementType::FP16:
+      Fill<uint16_t>(frame, tensor);
+      break;
+    case ElementType::FP32:
+      Fill<float>(frame, tensor);
+      break;
+  }
+}
+
+void GetLumaGrid(const Frame& frame,
+                 size_t grid_width,
+                 size_t grid_height,
+                 std::vector<float>* grid) {
+  const size_t bpp = GetBytesPerPixel(frame.format);
+  const bool bgr =
+      frame.format == PixelFormat::BGRA || frame.format == PixelFormat::BGR;
+  const size_t r = bgr ? 2 : 0;
+  const size_t b = bgr ? 0 : 2;
+  // A cell average does not need every pixel; at least 16 x 16 of them are
+  // sampled per cell.
+  const size_t step_x = std::max<size_t>(1, frame.width / (grid_width * 16));
+  const size_t step_y = std::max<size_t>(1, frame.height / (grid_height * 16));
+
+  grid->resize(grid_width * grid_height);
+  for (size_t cell_y = 0; cell_y < grid_height; ++cell_y) {
+    const size_t top = cell_y * frame.height / grid_height;
+    const size_t bottom = (cell_y + 1) * frame.height / grid_height;
+    for (size_t cell_x = 0; cell_x < grid_width; ++cell_x) {
+      const size_t left = cell_x * frame.width / grid_width;
+      const size_t right = (cell_x + 1) * frame.width / grid_width;
+      uint64_t sum = 0;
+      size_t count = 0;
+      for (size_t y = top; y < bottom; y += step_y) {
+        const uint8_t* row = frame.data + y * frame.stride;
+        uint32_t row_sum = 0;
+        for (size_t x = left; x < right; x += step_x) {
+          const uint8_t* pixel = row + x * bpp;
+          // BT.601 weights in 8-bit fixed point.
+          row_sum += pixel[r] * 77 + pixel[1] * 150 + pixel[b] * 29;
+        }
+        sum += row_sum;
+        count += (right - left + step_x - 1) / step_x;
+      }
+      (*grid)[cell_y * grid_width + cell_x] =
+          static_cast<float>(sum / (count * 256.0 * 255.0));
+    }
+  }
+}
+
+}  // namespace image
+
+}  // namespace ienodejs
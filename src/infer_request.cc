@@ -1,8 +1,15 @@
 #include "infer_request.h"
 #include "blob.h"
+#include "ring_buffer.h"
+#include "utils.h"
 
 #include <napi.h>
 #include <uv.h>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <vector>
 
 #include "inference_engine.hpp"
 
@@ -14,11 +21,19 @@ namespace ienodejs {
 
 class InferAsyncWorker : public Napi::AsyncWorker {
  public:
+  // |receiver| keeps the JS InferRequest alive while the inference is
+  // running, and with it the memory bound by setBlob, which dispose() keeps
+  // until the inference completes.
   InferAsyncWorker(Napi::Env& env,
+                   const Napi::Object& receiver,
+                   InferRequest* request,
                    const ie::InferRequest& infer_request,
+                   const std::shared_ptr<BlobArena::BlobSet>& lease,
                    Napi::Promise::Deferred& deferred)
-      : Napi::AsyncWorker(env),
+      : Napi::AsyncWorker(receiver),
+        request_(request),
         infer_request_(infer_request),
+        lease_(lease),
         env_(env),
         deferred_(deferred) {}
 
@@ -36,26 +51,180 @@ class InferAsyncWorker : public Napi::AsyncWorker {
     }
   }
 
-  void OnOK() { deferred_.Resolve(Env().Null()); }
+  void OnOK() {
+    lease_.reset();
+    request_->OnInferenceDone();
+    deferred_.Resolve(Env().Null());
+  }
 
-  void OnError(Napi::Error const& error) { deferred_.Reject(error.Value()); }
+  void OnError(Napi::Error const& error) {
+    lease_.reset();
+    request_->OnInferenceDone();
+    deferred_.Reject(error.Value());
+  }
 
  private:
+  InferRequest* request_;
   InferenceEngine::InferRequest infer_request_;
+  // Keeps the leased blobs out of the arena until the inference is done.
+  std::shared_ptr<BlobArena::BlobSet> lease_;
   Napi::Env env_;
   Napi::Promise::Deferred deferred_;
 };
 
+// Copies the inputs in, infers and copies the outputs out on a worker thread,
+// so that InferRequest.run() takes a single N-API round trip.
+class RunAsyncWorker : public Napi::AsyncWorker {
+ public:
+  struct Copy {
+    std::string name;
+    void* data;
+    size_t byte_size;
+  };
+
+  RunAsyncWorker(const Napi::Object& receiver,
+                 InferRequest* request,
+                 const ie::InferRequest& infer_request,
+                 const std::shared_ptr<BlobArena::BlobSet>& lease,
+                 const std::vector<Copy>& inputs,
+                 const std::vector<Copy>& outputs,
+                 const Napi::Object& input_arrays,
+                 const Napi::Object& output_arrays,
+                 Napi::Promise::Deferred& deferred)
+      : Napi::AsyncWorker(receiver),
+        request_(request),
+        infer_request_(infer_request),
+        lease_(lease),
+        inputs_(inputs),
+        outputs_(outputs),
+        input_arrays_(Napi::Persistent(input_arrays)),
+        output_arrays_(Napi::Persistent(output_arrays)),
+        deferred_(deferred) {}
+
+  ~RunAsyncWorker() {}
+
+  void Execute() {
+    try {
+      for (auto& input : inputs_) {
+        ie::MemoryBlob::Ptr blob =
+            ie::as<ie::MemoryBlob>(infer_request_.GetBlob(input.name));
+        if (!blob) {
+          Napi::AsyncWorker::SetError("Not able to cast Blob to MemoryBlob");
+          return;
+        }
+        ie::LockedMemory<void> memory = blob->wmap();
+        memcpy(memory.as<void*>(), input.data, input.byte_size);
+      }
+      infer_request_.Infer();
+      for (auto& output : outputs_) {
+        ie::MemoryBlob::Ptr blob =
+            ie::as<ie::MemoryBlob>(infer_request_.GetBlob(output.name));
+        if (!blob) {
+          Napi::AsyncWorker::SetError("Not able to cast Blob to MemoryBlob");
+          return;
+        }
+        ie::LockedMemory<const void> memory = blob->rmap();
+        memcpy(output.data, memory.as<const void*>(), output.byte_size);
+      }
+    } catch (const std::exception& error) {
+      Napi::AsyncWorker::SetError(error.what());
+      return;
+    } catch (...) {
+      Napi::AsyncWorker::SetError("Unknown/internal exception happened.");
+      return;
+    }
+  }
+
+  void OnOK() {
+    lease_.reset();
+    request_->OnInferenceDone();
+    deferred_.Resolve(output_arrays_.Value());
+  }
+
+  void OnError(Napi::Error const& error) {
+    lease_.reset();
+    request_->OnInferenceDone();
+    deferred_.Reject(error.Value());
+  }
+
+ private:
+  InferRequest* request_;
+  InferenceEngine::InferRequest infer_request_;
+  std::shared_ptr<BlobArena::BlobSet> lease_;
+  std::vector<Copy> inputs_;
+  std::vector<Copy> outputs_;
+  // Keep the TypedArrays alive while their memory is accessed.
+  Napi::ObjectReference input_arrays_;
+  Napi::ObjectReference output_arrays_;
+  Napi::Promise::Deferred deferred_;
+};
+
+namespace {
+
+// Returns an empty value if |array| can back a blob of |desc|, otherwise the
+// error to report.
+Napi::Value CheckTypedArray(const Napi::Env& env,
+                            const Napi::TypedArray& array,
+                            const ie::TensorDesc& desc) {
+  if (!utils::IsTypedArrayOfPrecision(array.TypedArrayType(),
+                                      desc.getPrecision())) {
+    return Napi::TypeError::New(
+               env, "The TypedArray does not match the precision " +
+                        utils::GetNameOfPrecision(desc.getPrecision()))
+        .Value();
+  }
+  if (array.ByteLength() != utils::GetByteSizeOfTensorDesc(desc)) {
+    return Napi::RangeError::New(env, "The TypedArray does not match the dims")
+        .Value();
+  }
+  return Napi::Value();
+}
+
+// The u8 NHWC desc of a packed RGBX or BGRX frame, e.g. the data of an
+// ImageData, with the batch and size of |input|.
+ie::TensorDesc GetPackedImageDesc(const ie::TensorDesc& input) {
+  ie::SizeVector dims = input.getDims();
+  if (dims.size() != 4) {
+    throw std::invalid_argument(
+        "A tensorDesc is needed for inputs that are not images");
+  }
+  dims[1] = 4;
+  return ie::TensorDesc(ie::Precision::U8, dims, ie::Layout::NHWC);
+}
+
+bool IsByteArray(const Napi::Value& value) {
+  if (!value.IsTypedArray()) {
+    return false;
+  }
+  napi_typedarray_type type = value.As<Napi::TypedArray>().TypedArrayType();
+  return type == napi_uint8_array || type == napi_uint8_clamped_array;
+}
+
+}  // namespace
+
 Napi::FunctionReference InferRequest::constructor;
 
 void InferRequest::Init(const Napi::Env& env) {
   Napi::HandleScope scope(env);
 
-  Napi::Function func =
-      DefineClass(env, "InferRequest",
-                  {InstanceMethod("getBlob", &InferRequest::GetBlob),
-                   InstanceMethod("infer", &InferRequest::Infer),
-                   InstanceMethod("startAsync", &InferRequest::StartAsync)});
+  Napi::Function func = DefineClass(
+      env, "InferRequest",
+      {InstanceMethod("getBlob", &InferRequest::GetBlob),
+       InstanceMethod("setBlob", &InferRequest::SetBlob),
+       InstanceMethod("setNV12Blob", &InferRequest::SetNV12Blob),
+       InstanceMethod("setI420Blob", &InferRequest::SetI420Blob),
+       InstanceMethod("infer", &InferRequest::Infer),
+       InstanceMethod("startAsync", &InferRequest::StartAsync),
+       InstanceMethod("run", &InferRequest::Run),
+       InstanceMethod("attachRingBuffer", &InferRequest::AttachRingBuffer),
+       InstanceMethod("detachRingBuffer", &InferRequest::DetachRingBuffer),
+       InstanceMethod("queryState", &InferRequest::QueryState),
+       InstanceMethod("getStates", &InferRequest::GetStates),
+       InstanceMethod("setStates", &InferRequest::SetStates),
+       InstanceMethod("resetStates", &InferRequest::ResetStates),
+       InstanceMethod("unbindBlobs", &InferRequest::UnbindBlobs),
+       InstanceMethod("releaseBlobs", &InferRequest::ReleaseBlobs),
+       InstanceMethod("dispose", &InferRequest::Dispose)});
 
   constructor = Napi::Persistent(func);
   constructor.SuppressDestruct();
@@ -64,19 +233,44 @@ void InferRequest::Init(const Napi::Env& env) {
 InferRequest::InferRequest(const Napi::CallbackInfo& info)
     : Napi::ObjectWrap<InferRequest>(info) {}
 
-Napi::Value InferRequest::NewInstance(const Napi::Env& env,
-                                      const ie::InferRequest& actual) {
+InferRequest::~InferRequest() {
+  if (external_memory_ > 0) {
+    Napi::MemoryManagement::AdjustExternalMemory(Env(), -external_memory_);
+  }
+}
+
+Napi::Value InferRequest::NewInstance(
+    const Napi::Env& env,
+    const ie::InferRequest& actual,
+    const std::shared_ptr<BlobArena>& arena,
+    const std::vector<std::string>& output_names,
+    int64_t external_memory) {
   Napi::EscapableHandleScope scope(env);
 
   Napi::Object obj = constructor.New({});
   InferRequest* infer_Request = Napi::ObjectWrap<InferRequest>::Unwrap(obj);
   infer_Request->actual_ = actual;
+  infer_Request->arena_ = arena;
+  infer_Request->output_names_ = output_names;
+  infer_Request->external_memory_ = external_memory;
+  Napi::MemoryManagement::AdjustExternalMemory(env, external_memory);
+  if (arena) {
+    // The blobs the plugin allocated for the request are freed.
+    for (auto& blob : arena->GetIdleSet()) {
+      infer_Request->KeepOwnPreProcess(blob.first);
+      infer_Request->actual_.SetBlob(blob.first, blob.second);
+      infer_Request->own_blobs_[blob.first] = blob.second;
+    }
+  }
 
   return scope.Escape(napi_value(obj)).ToObject();
 }
 
 Napi::Value InferRequest::GetBlob(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
+  if (CheckDisposed(env)) {
+    return env.Null();
+  }
 
   if (info.Length() != 1) {
     Napi::TypeError::New(env, "Wrong number of arguments")
@@ -92,8 +286,26 @@ Napi::Value InferRequest::GetBlob(const Napi::CallbackInfo& info) {
 
   std::string name = info[0].ToString();
   try {
+    if (!AcquireBlobs()) {
+      Napi::RangeError::New(env, "Blob arena is exhausted")
+          .ThrowAsJavaScriptException();
+      return env.Null();
+    }
+    // The lease is kept for the Blob until releaseBlobs(), which disposes it.
+    keep_lease_ = lease_ != nullptr;
     ie::Blob::Ptr blob = actual_.GetBlob(name);
-    return Blob::NewInstance(env, blob);
+    if (!lease_ || !lease_->count(name) || lease_->at(name) != blob) {
+      return Blob::NewInstance(env, blob, nullptr);
+    }
+    Napi::Value leased_blob = Blob::NewInstance(env, blob, lease_);
+    leased_blobs_.erase(
+        std::remove_if(leased_blobs_.begin(), leased_blobs_.end(),
+                       [](Napi::ObjectReference& reference) {
+                         return reference.Value().IsEmpty();
+                       }),
+        leased_blobs_.end());
+    leased_blobs_.push_back(Napi::Weak(leased_blob.ToObject()));
+    return leased_blob;
   } catch (const std::exception& error) {
     Napi::RangeError::New(env, error.what()).ThrowAsJavaScriptException();
     return env.Null();
@@ -104,38 +316,853 @@ Napi::Value InferRequest::GetBlob(const Napi::CallbackInfo& info) {
   }
 }
 
+void InferRequest::SetBlob(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  if (CheckDisposed(env)) {
+    return;
+  }
+
+  if (info.Length() < 2 || info.Length() > 3) {
+    Napi::TypeError::New(env, "Wrong number of arguments")
+        .ThrowAsJavaScriptException();
+    return;
+  }
+
+  if (!info[0].IsString() || !info[1].IsObject() ||
+      (info.Length() == 3 && !info[2].IsObject())) {
+    Napi::TypeError::New(env, "Wrong type of arguments")
+        .ThrowAsJavaScriptException();
+    return;
+  }
+
+  std::string name = info[0].ToString();
+  Napi::Object data = info[1].ToObject();
+
+  // The options describe a TypedArray whose size or color format differs
+  // from the network input, and how the plugin converts it.
+  bool has_tensor_desc = false;
+  Napi::Object tensor_desc;
+  bool has_pre_process = false;
+  bool packed_image = false;
+  ie::PreProcessInfo pre_process;
+  if (info.Length() == 3) {
+    Napi::Object options = info[2].ToObject();
+    if (options.Has("tensorDesc")) {
+      Napi::Value value = options.Get("tensorDesc");
+      if (!value.IsObject() || !utils::checkTensorDesc(value.ToObject())) {
+        Napi::TypeError::New(env, "Wrong tensorDesc")
+            .ThrowAsJavaScriptException();
+        return;
+      }
+      has_tensor_desc = true;
+      tensor_desc = value.ToObject();
+    }
+    if (options.Has("resizeAlgorithm")) {
+      std::string algorithm = options.Get("resizeAlgorithm").ToString();
+      if (!utils::IsResizeAlgorithmName(algorithm)) {
+        Napi::TypeError::New(env, "Wrong resizeAlgorithm")
+            .ThrowAsJavaScriptException();
+        return;
+      }
+      pre_process.setResizeAlgorithm(
+          utils::GetResizeAlgorithmByName(algorithm));
+      has_pre_process = true;
+    }
+    if (options.Has("colorFormat")) {
+      std::string format = options.Get("colorFormat").ToString();
+      if (!utils::IsColorFormatName(format)) {
+        Napi::TypeError::New(env, "Wrong colorFormat")
+            .ThrowAsJavaScriptException();
+        return;
+      }
+      pre_process.setColorFormat(utils::GetColorFormatByName(format));
+      has_pre_process = true;
+      packed_image = format == "rgbx" || format == "bgrx";
+    }
+  }
+
+  try {
+    ie::Blob::Ptr blob;
+    if (data.InstanceOf(Blob::constructor.Value())) {
+      Blob* blob_object = Napi::ObjectWrap<Blob>::Unwrap(data);
+      if (blob_object->CheckDisposed(env)) {
+        return;
+      }
+      blob = blob_object->actual_;
+    } else if (data.IsTypedArray()) {
+      // The memory of the TypedArray, which may be a SharedArrayBuffer filled
+      // by other threads, is used in place.
+      Napi::TypedArray array = data.As<Napi::TypedArray>();
+      ie::TensorDesc desc = actual_.GetBlob(name)->getTensorDesc();
+      if (has_tensor_desc) {
+        desc = utils::GetTensorDescFromObject(tensor_desc);
+      } else if (packed_image) {
+        // A frame of the input size needs no tensorDesc; the plugin drops
+        // the fourth channel.
+        desc = GetPackedImageDesc(desc);
+      }
+      Napi::Value error = CheckTypedArray(env, array, desc);
+      if (!error.IsEmpty()) {
+        Napi::Error(env, error).ThrowAsJavaScriptException();
+        return;
+      }
+      blob = utils::WrapBlob(desc, utils::GetTypedArrayData(array));
+    } else {
+      Napi::TypeError::New(env, "Wrong type of arguments")
+          .ThrowAsJavaScriptException();
+      return;
+    }
+
+    KeepOwnBlob(name);
+    if (has_pre_process) {
+      actual_.SetBlob(name, blob, pre_process);
+    } else {
+      actual_.SetBlob(name, blob);
+    }
+    bound_objects_[name] = Napi::Persistent(data);
+  } catch (const std::exception& error) {
+    Napi::RangeError::New(env, error.what()).ThrowAsJavaScriptException();
+  } catch (...) {
+    Napi::Error::New(env, "Unknown/internal exception happened.")
+        .ThrowAsJavaScriptException();
+  }
+}
+
+void InferRequest::SetYUVBlob(const Napi::CallbackInfo& info,
+                              const ie::ColorFormat& format) {
+  Napi::Env env = info.Env();
+  if (CheckDisposed(env)) {
+    return;
+  }
+
+  // NV12 has an interleaved UV plane, I420 separate U and V planes.
+  const size_t planes = format == ie::ColorFormat::NV12 ? 2 : 3;
+  if (info.Length() < planes + 3 || info.Length() > planes + 4) {
+    Napi::TypeError::New(env, "Wrong number of arguments")
+        .ThrowAsJavaScriptException();
+    return;
+  }
+
+  bool valid = info[0].IsString() && info[planes + 1].IsNumber() &&
+               info[planes + 2].IsNumber() &&
+               (info.Length() == planes + 3 || info[planes + 3].IsObject());
+  for (size_t i = 1; i <= planes; ++i) {
+    valid = valid && IsByteArray(info[i]);
+  }
+  if (!valid) {
+    Napi::TypeError::New(env, "Wrong type of arguments")
+        .ThrowAsJavaScriptException();
+    return;
+  }
+
+  std::string name = info[0].ToString();
+  size_t width = info[planes + 1].ToNumber().Uint32Value();
+  size_t height = info[planes + 2].ToNumber().Uint32Value();
+  if (width == 0 || height == 0 || width % 2 != 0 || height % 2 != 0) {
+    Napi::RangeError::New(env, "The width and height should be even")
+        .ThrowAsJavaScriptException();
+    return;
+  }
+
+  ie::PreProcessInfo pre_process;
+  pre_process.setColorFormat(format);
+  if (info.Length() == planes + 4) {
+    Napi::Object options = info[planes + 3].ToObject();
+    if (options.Has("resizeAlgorithm")) {
+      std::string algorithm = options.Get("resizeAlgorithm").ToString();
+      if (!utils::IsResizeAlgorithmName(algorithm)) {
+        Napi::TypeError::New(env, "Wrong resizeAlgorithm")
+            .ThrowAsJavaScriptException();
+        return;
+      }
+      pre_process.setResizeAlgorithm(
+          utils::GetResizeAlgorithmByName(algorithm));
+    }
+  }
+
+  // The chroma planes are subsampled by two in both directions.
+  std::vector<ie::Blob::Ptr> blobs;
+  Napi::Array arrays = Napi::Array::New(env, planes);
+  for (size_t i = 0; i < planes; ++i) {
+    Napi::TypedArray array = info[i + 1].As<Napi::TypedArray>();
+    size_t channels = format == ie::ColorFormat::NV12 && i == 1 ? 2 : 1;
+    size_t plane_width = i == 0 ? width : width / 2;
+    size_t plane_height = i == 0 ? height : height / 2;
+    if (array.ByteLength() < channels * plane_width * plane_height) {
+      Napi::RangeError::New(env, "The plane is too short for the frame")
+          .ThrowAsJavaScriptException();
+      return;
+    }
+    ie::TensorDesc desc(ie::Precision::U8,
+                        {1, channels, plane_height, plane_width},
+                        ie::Layout::NHWC);
+    blobs.push_back(utils::WrapBlob(desc, utils::GetTypedArrayData(array)));
+    arrays.Set(static_cast<uint32_t>(i), array);
+  }
+
+  try {
+    ie::Blob::Ptr blob;
+    if (format == ie::ColorFormat::NV12) {
+      blob = ie::make_shared_blob<ie::NV12Blob>(blobs[0], blobs[1]);
+    } else {
+      blob = ie::make_shared_blob<ie::I420Blob>(blobs[0], blobs[1], blobs[2]);
+    }
+    KeepOwnBlob(name);
+    actual_.SetBlob(name, blob, pre_process);
+    // The planes are used in place, so they stay referenced with the blob.
+    bound_objects_[name] = Napi::Persistent(arrays.As<Napi::Object>());
+  } catch (const std::exception& error) {
+    Napi::RangeError::New(env, error.what()).ThrowAsJavaScriptException();
+  } catch (...) {
+    Napi::Error::New(env, "Unknown/internal exception happened.")
+        .ThrowAsJavaScriptException();
+  }
+}
+
 Napi::Value InferRequest::Infer(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
+  if (CheckDisposed(env)) {
+    return env.Null();
+  }
   if (info.Length() > 0) {
     Napi::TypeError::New(env, "Invalid argument").ThrowAsJavaScriptException();
     return Napi::Object::New(env);
   }
+  running_++;
   try {
+    if (!AcquireBlobs()) {
+      OnInferenceDone();
+      Napi::RangeError::New(env, "Blob arena is exhausted")
+          .ThrowAsJavaScriptException();
+      return env.Null();
+    }
+    CopyRingBuffers();
     actual_.Infer();
   } catch (const std::exception& error) {
+    OnInferenceDone();
     Napi::Error::New(env, error.what()).ThrowAsJavaScriptException();
     return env.Null();
   } catch (...) {
+    OnInferenceDone();
     Napi::Error::New(env, "Unknown/internal exception happened.")
         .ThrowAsJavaScriptException();
     return env.Null();
   }
+  OnInferenceDone();
   return env.Null();
 }
 
 Napi::Value InferRequest::StartAsync(const Napi::CallbackInfo& info) {
   auto env = info.Env();
   auto deferred = Napi::Promise::Deferred::New(env);
+  if (disposed_) {
+    return RejectDisposed(env, deferred);
+  }
   if (info.Length() > 0) {
     deferred.Reject(
         Napi::TypeError::New(env, "Wrong number of arguments").Value());
     return deferred.Promise();
   }
 
-  auto infer_worker = new InferAsyncWorker(env, actual_, deferred);
+  // The lease is taken for the inference, and returned by the worker when
+  // it completes unless getBlob keeps it.
+  running_++;
+  try {
+    if (!AcquireBlobs()) {
+      OnInferenceDone();
+      deferred.Reject(
+          Napi::RangeError::New(env, "Blob arena is exhausted").Value());
+      return deferred.Promise();
+    }
+    CopyRingBuffers();
+  } catch (const std::exception& error) {
+    OnInferenceDone();
+    deferred.Reject(Napi::Error::New(env, error.what()).Value());
+    return deferred.Promise();
+  } catch (...) {
+    OnInferenceDone();
+    deferred.Reject(
+        Napi::Error::New(env, "Unknown/internal exception happened.").Value());
+    return deferred.Promise();
+  }
+
+  auto infer_worker = new InferAsyncWorker(env, info.This().ToObject(), this,
+                                           actual_, lease_, deferred);
   infer_worker->Queue();
 
   return deferred.Promise();
 }
 
+Napi::Value InferRequest::Run(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+  if (disposed_) {
+    return RejectDisposed(env, deferred);
+  }
+
+  if (info.Length() < 1 || info.Length() > 2) {
+    deferred.Reject(
+        Napi::TypeError::New(env, "Wrong number of arguments").Value());
+    return deferred.Promise();
+  }
+
+  if (!info[0].IsObject() || (info.Length() == 2 && !info[1].IsObject())) {
+    deferred.Reject(
+        Napi::TypeError::New(env, "Wrong type of arguments").Value());
+    return deferred.Promise();
+  }
+
+  Napi::Object inputs = info[0].ToObject();
+  Napi::Object outputs =
+      info.Length() == 2 ? info[1].ToObject() : Napi::Object::New(env);
+  Napi::Object input_arrays = Napi::Object::New(env);
+  Napi::Object output_arrays = Napi::Object::New(env);
+  std::vector<RunAsyncWorker::Copy> input_copies;
+  std::vector<RunAsyncWorker::Copy> output_copies;
+
+  try {
+    Napi::Array input_names = inputs.GetPropertyNames();
+    for (uint32_t i = 0; i < input_names.Length(); ++i) {
+      std::string name = input_names.Get(i).ToString();
+      Napi::Value value = inputs.Get(name);
+      if (!value.IsTypedArray()) {
+        deferred.Reject(
+            Napi::TypeError::New(env, "Input " + name + " is not a TypedArray")
+                .Value());
+        return deferred.Promise();
+      }
+      Napi::TypedArray array = value.As<Napi::TypedArray>();
+      Napi::Value error = CheckTypedArray(
+          env, array, actual_.GetBlob(name)->getTensorDesc());
+      if (!error.IsEmpty()) {
+        deferred.Reject(error);
+        return deferred.Promise();
+      }
+      input_arrays.Set(name, array);
+      input_copies.push_back(
+          {name, utils::GetTypedArrayData(array), array.ByteLength()});
+    }
+
+    for (auto& name : output_names_) {
+      ie::TensorDesc desc = actual_.GetBlob(name)->getTensorDesc();
+      Napi::TypedArray array;
+      if (outputs.Has(name)) {
+        Napi::Value value = outputs.Get(name);
+        if (!value.IsTypedArray()) {
+          deferred.Reject(Napi::TypeError::New(
+                              env, "Output " + name + " is not a TypedArray")
+                              .Value());
+          return deferred.Promise();
+        }
+        array = value.As<Napi::TypedArray>();
+        Napi::Value error = CheckTypedArray(env, array, desc);
+        if (!error.IsEmpty()) {
+          deferred.Reject(error);
+          return deferred.Promise();
+        }
+      } else {
+        auto cached = output_arrays_.find(name);
+        if (cached == output_arrays_.end()) {
+          array = utils::CreateTypedArray(
+              env, desc.getPrecision(),
+              utils::GetByteSizeOfTensorDesc(desc) /
+                  desc.getPrecision().size());
+          output_arrays_[name] = Napi::Persistent(array.As<Napi::Object>());
+        } else {
+          array = cached->second.Value().As<Napi::TypedArray>();
+        }
+      }
+      output_arrays.Set(name, array);
+      output_copies.push_back(
+          {name, utils::GetTypedArrayData(array), array.ByteLength()});
+    }
+  } catch (const std::exception& error) {
+    deferred.Reject(Napi::RangeError::New(env, error.what()).Value());
+    return deferred.Promise();
+  } catch (...) {
+    deferred.Reject(
+        Napi::Error::New(env, "Unknown/internal exception happened.").Value());
+    return deferred.Promise();
+  }
+
+  // The lease is taken once the arguments are checked, and returned by the
+  // worker when it completes unless getBlob keeps it.
+  running_++;
+  try {
+    if (!AcquireBlobs()) {
+      OnInferenceDone();
+      deferred.Reject(
+          Napi::RangeError::New(env, "Blob arena is exhausted").Value());
+      return deferred.Promise();
+    }
+    // Inputs given to run() are copied later and take precedence.
+    CopyRingBuffers();
+  } catch (const std::exception& error) {
+    OnInferenceDone();
+    deferred.Reject(Napi::Error::New(env, error.what()).Value());
+    return deferred.Promise();
+  } catch (...) {
+    OnInferenceDone();
+    deferred.Reject(
+        Napi::Error::New(env, "Unknown/internal exception happened.").Value());
+    return deferred.Promise();
+  }
+
+  auto run_worker = new RunAsyncWorker(
+      info.This().ToObject(), this, actual_, lease_, input_copies,
+      output_copies, input_arrays, output_arrays, deferred);
+  run_worker->Queue();
+
+  return deferred.Promise();
+}
+
+Napi::Value InferRequest::AttachRingBuffer(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  if (CheckDisposed(env)) {
+    return env.Null();
+  }
+  if (info.Length() < 1 || info.Length() > 2) {
+    Napi::TypeError::New(env, "Wrong number of arguments")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  if (!info[0].IsString() || (info.Length() == 2 && !info[1].IsObject())) {
+    Napi::TypeError::New(env, "Wrong type of arguments")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  std::string name = info[0].ToString();
+  try {
+    // The window is the whole input, whose leading dims are time.
+    ie::TensorDesc desc = actual_.GetBlob(name)->getTensorDesc();
+    const size_t window =
+        utils::GetByteSizeOfTensorDesc(desc) / desc.getPrecision().size();
+    size_t hop = window;
+    if (info.Length() == 2 && info[1].ToObject().Has("hop")) {
+      Napi::Value value = info[1].ToObject().Get("hop");
+      if (!value.IsNumber()) {
+        Napi::TypeError::New(env, "hop should be a number")
+            .ThrowAsJavaScriptException();
+        return env.Null();
+      }
+      hop = value.ToNumber().Uint32Value();
+      if (hop == 0 || hop > window) {
+        Napi::RangeError::New(env, "hop should be in [1, window]")
+            .ThrowAsJavaScriptException();
+        return env.Null();
+      }
+    }
+    Napi::Value ring =
+        RingBuffer::NewInstance(env, desc.getPrecision(), window, hop);
+    ring_buffers_[name] = Napi::Persistent(ring.ToObject());
+    return ring;
+  } catch (const std::exception& error) {
+    Napi::RangeError::New(env, error.what()).ThrowAsJavaScriptException();
+    return env.Null();
+  } catch (...) {
+    Napi::Error::New(env, "Unknown/internal exception happened.")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+}
+
+void InferRequest::DetachRingBuffer(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  if (CheckDisposed(env)) {
+    return;
+  }
+  if (info.Length() != 1) {
+    Napi::TypeError::New(env, "Wrong number of arguments")
+        .ThrowAsJavaScriptException();
+    return;
+  }
+  if (!info[0].IsString()) {
+    Napi::TypeError::New(env, "Wrong type of arguments")
+        .ThrowAsJavaScriptException();
+    return;
+  }
+  ring_buffers_.erase(info[0].ToString());
+}
+
+Napi::Value InferRequest::QueryState(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  if (CheckDisposed(env)) {
+    return env.Null();
+  }
+  if (info.Length() > 0) {
+    Napi::TypeError::New(env, "Invalid argument").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  try {
+    std::vector<ie::VariableState> states = actual_.QueryState();
+    Napi::Array result = Napi::Array::New(env, states.size());
+    for (size_t i = 0; i < states.size(); ++i) {
+      Napi::Object state = Napi::Object::New(env);
+      state.Set("name", states[i].GetName());
+      state.Set("tensorDesc",
+                utils::CreateTensorDescObject(
+                    env, states[i].GetState()->getTensorDesc()));
+      result.Set(static_cast<uint32_t>(i), state);
+    }
+    return result;
+  } catch (const std::exception& error) {
+    Napi::Error::New(env, error.what()).ThrowAsJavaScriptException();
+    return env.Null();
+  } catch (...) {
+    Napi::Error::New(env, "Unknown/internal exception happened.")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+}
+
+Napi::Value InferRequest::GetStates(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  if (CheckDisposed(env)) {
+    return env.Null();
+  }
+  if (info.Length() > 1) {
+    Napi::TypeError::New(env, "Wrong number of arguments")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  if (info.Length() == 1 && !info[0].IsObject()) {
+    Napi::TypeError::New(env, "Wrong type of arguments")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  // The states are copied into the TypedArrays given by name, so that the
+  // caller can keep one snapshot per stream without allocating.
+  Napi::Object states =
+      info.Length() == 1 ? info[0].ToObject() : Napi::Object::New(env);
+  try {
+    for (auto& state : actual_.QueryState()) {
+      ie::MemoryBlob::CPtr blob = ie::as<ie::MemoryBlob>(state.GetState());
+      if (!blob) {
+        throw std::invalid_argument("Not able to cast Blob to MemoryBlob");
+      }
+      const ie::TensorDesc& desc = blob->getTensorDesc();
+      const std::string name = state.GetName();
+      Napi::TypedArray array;
+      if (states.Has(name)) {
+        Napi::Value value = states.Get(name);
+        if (!value.IsTypedArray()) {
+          Napi::TypeError::New(env, "State " + name + " is not a TypedArray")
+              .ThrowAsJavaScriptException();
+          return env.Null();
+        }
+        array = value.As<Napi::TypedArray>();
+        Napi::Value error = CheckTypedArray(env, array, desc);
+        if (!error.IsEmpty()) {
+          Napi::Error(env, error).ThrowAsJavaScriptException();
+          return env.Null();
+        }
+      } else {
+        array = utils::CreateTypedArray(
+            env, desc.getPrecision(),
+            utils::GetByteSizeOfTensorDesc(desc) / desc.getPrecision().size());
+        states.Set(name, array);
+      }
+      ie::LockedMemory<const void> memory = blob->rmap();
+      memcpy(utils::GetTypedArrayData(array), memory.as<const void*>(),
+             array.ByteLength());
+    }
+  } catch (const std::exception& error) {
+    Napi::Error::New(env, error.what()).ThrowAsJavaScriptException();
+    return env.Null();
+  } catch (...) {
+    Napi::Error::New(env, "Unknown/internal exception happened.")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  return states;
+}
+
+void InferRequest::SetStates(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  if (CheckDisposed(env)) {
+    return;
+  }
+  if (info.Length() != 1) {
+    Napi::TypeError::New(env, "Wrong number of arguments")
+        .ThrowAsJavaScriptException();
+    return;
+  }
+  if (!info[0].IsObject()) {
+    Napi::TypeError::New(env, "Wrong type of arguments")
+        .ThrowAsJavaScriptException();
+    return;
+  }
+
+  Napi::Object states = info[0].ToObject();
+  try {
+    std::vector<ie::VariableState> actual_states = actual_.QueryState();
+    // Every state is checked before any is set, so that a bad snapshot does
+    // not leave the request with a mix of two streams.
+    std::vector<std::pair<ie::VariableState*, Napi::TypedArray>> updates;
+    Napi::Array names = states.GetPropertyNames();
+    for (uint32_t i = 0; i < names.Length(); ++i) {
+      std::string name = names.Get(i).ToString();
+      auto state = std::find_if(actual_states.begin(), actual_states.end(),
+                                [&name](ie::VariableState& candidate) {
+                                  return candidate.GetName() == name;
+                                });
+      if (state == actual_states.end()) {
+        Napi::RangeError::New(env, "Unknown state " + name)
+            .ThrowAsJavaScriptException();
+        return;
+      }
+      Napi::Value value = states.Get(name);
+      if (!value.IsTypedArray()) {
+        Napi::TypeError::New(env, "State " + name + " is not a TypedArray")
+            .ThrowAsJavaScriptException();
+        return;
+      }
+      Napi::TypedArray array = value.As<Napi::TypedArray>();
+      Napi::Value error =
+          CheckTypedArray(env, array, state->GetState()->getTensorDesc());
+      if (!error.IsEmpty()) {
+        Napi::Error(env, error).ThrowAsJavaScriptException();
+        return;
+      }
+      updates.emplace_back(&*state, array);
+    }
+    for (auto& update : updates) {
+      ie::Blob::Ptr blob =
+          utils::AllocateBlob(update.first->GetState()->getTensorDesc());
+      {
+        ie::LockedMemory<void> memory = ie::as<ie::MemoryBlob>(blob)->wmap();
+        memcpy(memory.as<void*>(), utils::GetTypedArrayData(update.second),
+               update.second.ByteLength());
+      }
+      update.first->SetState(blob);
+    }
+  } catch (const std::exception& error) {
+    Napi::Error::New(env, error.what()).ThrowAsJavaScriptException();
+  } catch (...) {
+    Napi::Error::New(env, "Unknown/internal exception happened.")
+        .ThrowAsJavaScriptException();
+  }
+}
+
+void InferRequest::ResetStates(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  if (CheckDisposed(env)) {
+    return;
+  }
+  if (info.Length() > 0) {
+    Napi::TypeError::New(env, "Invalid argument").ThrowAsJavaScriptException();
+    return;
+  }
+  try {
+    for (auto& state : actual_.QueryState()) {
+      state.Reset();
+    }
+  } catch (const std::exception& error) {
+    Napi::Error::New(env, error.what()).ThrowAsJavaScriptException();
+  } catch (...) {
+    Napi::Error::New(env, "Unknown/internal exception happened.")
+        .ThrowAsJavaScriptException();
+  }
+}
+
+void InferRequest::UnbindBlobs(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  if (CheckDisposed(env)) {
+    return;
+  }
+  if (info.Length() > 0) {
+    Napi::TypeError::New(env, "Invalid argument").ThrowAsJavaScriptException();
+    return;
+  }
+
+  try {
+    while (!bound_objects_.empty()) {
+      const std::string name = bound_objects_.begin()->first;
+      // The leased blob if the request holds a lease, or its own one.
+      if (lease_ && lease_->count(name)) {
+        BindOwnBlob(name, lease_->at(name));
+      } else {
+        BindOwnBlob(name, own_blobs_.at(name));
+      }
+      bound_objects_.erase(name);
+    }
+  } catch (const std::exception& error) {
+    Napi::Error::New(env, error.what()).ThrowAsJavaScriptException();
+  } catch (...) {
+    Napi::Error::New(env, "Unknown/internal exception happened.")
+        .ThrowAsJavaScriptException();
+  }
+}
+
+void InferRequest::ReleaseBlobs(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  if (CheckDisposed(env)) {
+    return;
+  }
+  if (info.Length() > 0) {
+    Napi::TypeError::New(env, "Invalid argument").ThrowAsJavaScriptException();
+    return;
+  }
+  keep_lease_ = false;
+  // A running inference returns the lease when it completes.
+  if (running_ == 0) {
+    ReleaseLease();
+  }
+}
+
+void InferRequest::Dispose(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  if (info.Length() > 0) {
+    Napi::TypeError::New(env, "Invalid argument").ThrowAsJavaScriptException();
+    return;
+  }
+
+  disposed_ = true;
+  // A running inference still uses the memory bound by setBlob and the
+  // output arrays, so the last one to complete releases them.
+  if (running_ == 0) {
+    Release(env);
+  }
+}
+
+void InferRequest::Release(const Napi::Env& env) {
+  ReleaseLease();
+  actual_ = ie::InferRequest();
+  own_blobs_.clear();
+  own_pre_process_.clear();
+  bound_objects_.clear();
+  output_arrays_.clear();
+  ring_buffers_.clear();
+  if (external_memory_ > 0) {
+    Napi::MemoryManagement::AdjustExternalMemory(env, -external_memory_);
+    external_memory_ = 0;
+  }
+}
+
+bool InferRequest::CheckDisposed(const Napi::Env& env) {
+  if (disposed_) {
+    Napi::Error::New(env, "The InferRequest has been disposed")
+        .ThrowAsJavaScriptException();
+  }
+  return disposed_;
+}
+
+Napi::Value InferRequest::RejectDisposed(const Napi::Env& env,
+                                         Napi::Promise::Deferred& deferred) {
+  deferred.Reject(
+      Napi::Error::New(env, "The InferRequest has been disposed").Value());
+  return deferred.Promise();
+}
+
+void InferRequest::CopyRingBuffers() {
+  for (auto& entry : ring_buffers_) {
+    RingBuffer* ring =
+        Napi::ObjectWrap<RingBuffer>::Unwrap(entry.second.Value());
+    ie::MemoryBlob::Ptr blob =
+        ie::as<ie::MemoryBlob>(actual_.GetBlob(entry.first));
+    if (!blob) {
+      throw std::invalid_argument("Not able to cast Blob to MemoryBlob");
+    }
+    ie::LockedMemory<void> memory = blob->wmap();
+    ring->CopyWindow(memory.as<void*>(), blob->byteSize());
+  }
+}
+
+bool InferRequest::AcquireBlobs() {
+  if (!arena_ || lease_) {
+    return true;
+  }
+
+  std::shared_ptr<BlobArena::BlobSet> lease = arena_->Acquire();
+  if (!lease) {
+    return false;
+  }
+  try {
+    for (auto& blob : *lease) {
+      // Blobs bound by setBlob take precedence over the leased ones.
+      if (bound_objects_.find(blob.first) != bound_objects_.end()) {
+        continue;
+      }
+      KeepOwnBlob(blob.first);
+      BindOwnBlob(blob.first, blob.second);
+    }
+  } catch (...) {
+    // Do not keep a part of a set that goes back to the arena.
+    RebindOwnBlobs(*lease);
+    throw;
+  }
+  lease_ = lease;
+  return true;
+}
+
+void InferRequest::ReleaseLease() {
+  if (!lease_) {
+    return;
+  }
+  std::shared_ptr<BlobArena::BlobSet> lease = std::move(lease_);
+  // The Blobs and the ArrayBuffers they mapped must not reach the set once
+  // it is lent to another request.
+  for (auto& reference : leased_blobs_) {
+    Napi::Object blob = reference.Value();
+    if (!blob.IsEmpty()) {
+      Napi::ObjectWrap<Blob>::Unwrap(blob)->Release();
+    }
+  }
+  leased_blobs_.clear();
+  try {
+    RebindOwnBlobs(*lease);
+  } catch (...) {
+    // The request reads and writes its blobs only while it holds a lease, so
+    // a set that is still bound can go back to the arena.
+  }
+}
+
+void InferRequest::OnInferenceDone() {
+  running_--;
+  if (running_ > 0) {
+    return;
+  }
+  if (disposed_) {
+    Release(Env());
+  } else if (!keep_lease_) {
+    ReleaseLease();
+  }
+}
+
+void InferRequest::KeepOwnBlob(const std::string& name) {
+  if (own_blobs_.find(name) == own_blobs_.end()) {
+    own_blobs_[name] = actual_.GetBlob(name);
+    KeepOwnPreProcess(name);
+  }
+}
+
+void InferRequest::KeepOwnPreProcess(const std::string& name) {
+  if (std::find(output_names_.begin(), output_names_.end(), name) ==
+      output_names_.end()) {
+    own_pre_process_[name] = actual_.GetPreProcess(name);
+  }
+}
+
+void InferRequest::BindOwnBlob(const std::string& name,
+                               const ie::Blob::Ptr& blob) {
+  auto pre_process = own_pre_process_.find(name);
+  if (pre_process != own_pre_process_.end()) {
+    actual_.SetBlob(name, blob, pre_process->second);
+  } else {
+    actual_.SetBlob(name, blob);
+  }
+}
+
+void InferRequest::RebindOwnBlobs(const BlobArena::BlobSet& set) {
+  for (auto& blob : set) {
+    auto own_blob = own_blobs_.find(blob.first);
+    if (own_blob != own_blobs_.end() &&
+        actual_.GetBlob(blob.first) == blob.second) {
+      BindOwnBlob(blob.first, own_blob->second);
+    }
+  }
+}
+
 }  // namespace ienodejs
\ No newline at end of file
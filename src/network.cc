@@ -4,6 +4,7 @@
 
 #include <napi.h>
 #include <uv.h>
+#include <fstream>
 
 using namespace Napi;
 
@@ -22,6 +23,7 @@ class ReadNetworkAsyncWorker : public Napi::AsyncWorker {
         model_(model.As<Napi::String>()),
         read_from_data_(false),
         without_weights_(true),
+        weights_byte_size_(0),
         env_(env),
         deferred_(deferred) {}
 
@@ -35,6 +37,7 @@ class ReadNetworkAsyncWorker : public Napi::AsyncWorker {
         model_(model.As<Napi::String>()),
         read_from_data_(false),
         without_weights_(true),
+        weights_byte_size_(0),
         env_(env),
         deferred_(deferred) {
     if (weights.IsString()) {
@@ -46,6 +49,7 @@ class ReadNetworkAsyncWorker : public Napi::AsyncWorker {
                           ie::Layout::C);
       weights_blob_ =
           ie::make_shared_blob<uint8_t>(desc, (uint8_t*)buffer.Data());
+      weights_byte_size_ = buffer.ByteLength();
     }
   }
 
@@ -57,6 +61,13 @@ class ReadNetworkAsyncWorker : public Napi::AsyncWorker {
         actual_ = core_.ReadNetwork(model_, weights_blob_);
       } else {
         actual_ = core_.ReadNetwork(model_, weights_path_);
+        if (!weights_path_.empty()) {
+          std::ifstream weights(weights_path_,
+                                std::ios::binary | std::ios::ate);
+          if (weights) {
+            weights_byte_size_ = weights.tellg();
+          }
+        }
       }
     } catch (const std::exception& error) {
       Napi::AsyncWorker::SetError(error.what());
@@ -72,6 +83,9 @@ class ReadNetworkAsyncWorker : public Napi::AsyncWorker {
     Napi::Object obj = Network::constructor.New({});
     Network* network = Napi::ObjectWrap<Network>::Unwrap(obj);
     network->actual_ = actual_;
+    network->weights_byte_size_ = weights_byte_size_;
+    network->external_memory_ = weights_byte_size_;
+    Napi::MemoryManagement::AdjustExternalMemory(env_, weights_byte_size_);
     deferred_.Resolve(scope.Escape(napi_value(obj)).ToObject());
   }
 
@@ -85,6 +99,7 @@ class ReadNetworkAsyncWorker : public Napi::AsyncWorker {
   ie::Blob::CPtr weights_blob_;
   bool read_from_data_;
   bool without_weights_;
+  int64_t weights_byte_size_;
   Napi::Env env_;
   Napi::Promise::Deferred deferred_;
 };
@@ -100,6 +115,7 @@ void Network::Init(const Napi::Env& env) {
           InstanceMethod("getName", &Network::GetName),
           InstanceMethod("getInputsInfo", &Network::GetInputsInfo),
           InstanceMethod("getOutputsInfo", &Network::GetOutputsInfo),
+          InstanceMethod("dispose", &Network::Dispose),
       });
 
   constructor = Napi::Persistent(func);
@@ -109,6 +125,12 @@ void Network::Init(const Napi::Env& env) {
 Network::Network(const Napi::CallbackInfo& info)
     : Napi::ObjectWrap<Network>(info) {}
 
+Network::~Network() {
+  if (external_memory_ > 0) {
+    Napi::MemoryManagement::AdjustExternalMemory(Env(), -external_memory_);
+  }
+}
+
 void Network::NewInstanceAsync(Napi::Env env,
                                const Napi::CallbackInfo& info,
                                const InferenceEngine::Core& core,
@@ -127,6 +149,9 @@ void Network::NewInstanceAsync(Napi::Env env,
 
 Napi::Value Network::GetName(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
+  if (CheckDisposed(env)) {
+    return env.Null();
+  }
   if (info.Length() > 0) {
     Napi::TypeError::New(env, "Invalid argument").ThrowAsJavaScriptException();
     return Napi::Object::New(env);
@@ -136,6 +161,9 @@ Napi::Value Network::GetName(const Napi::CallbackInfo& info) {
 
 Napi::Value Network::GetInputsInfo(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
+  if (CheckDisposed(env)) {
+    return env.Null();
+  }
   if (info.Length() > 0) {
     Napi::TypeError::New(env, "Invalid argument").ThrowAsJavaScriptException();
     return Napi::Object::New(env);
@@ -151,6 +179,9 @@ Napi::Value Network::GetInputsInfo(const Napi::CallbackInfo& info) {
 
 Napi::Value Network::GetOutputsInfo(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
+  if (CheckDisposed(env)) {
+    return env.Null();
+  }
   if (info.Length() > 0) {
     Napi::TypeError::New(env, "Invalid argument").ThrowAsJavaScriptException();
     return Napi::Object::New(env);
@@ -165,4 +196,27 @@ Napi::Value Network::GetOutputsInfo(const Napi::CallbackInfo& info) {
   return js_outputs_info;
 }
 
-}  // namespace ienodejs
\ No newline at end of file
+void Network::Dispose(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  if (info.Length() > 0) {
+    Napi::TypeError::New(env, "Invalid argument").ThrowAsJavaScriptException();
+    return;
+  }
+
+  actual_ = ie::CNNNetwork();
+  disposed_ = true;
+  if (external_memory_ > 0) {
+    Napi::MemoryManagement::AdjustExternalMemory(env, -external_memory_);
+    external_memory_ = 0;
+  }
+}
+
+bool Network::CheckDisposed(const Napi::Env& env) {
+  if (disposed_) {
+    Napi::Error::New(env, "The Network has been disposed")
+        .ThrowAsJavaScriptException();
+  }
+  return disposed_;
+}
+
+}  // namespace ienodejs
@@ -0,0 +1,126 @@
+#include "parallel_for.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace ienodejs {
+
+namespace utils {
+
+namespace {
+
+// One worker per hardware thread but the caller's. The pool is never
+// destroyed, so that its threads do not have to be joined at exit.
+class ThreadPool {
+ public:
+  static ThreadPool& Get() {
+    static ThreadPool* pool = new ThreadPool();
+    return *pool;
+  }
+
+  size_t size() const { return size_; }
+
+  void Post(std::function<void()> task) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      tasks_.push_back(std::move(task));
+    }
+    ready_.notify_one();
+  }
+
+ private:
+  ThreadPool()
+      : size_(std::max<unsigned>(1, std::thread::hardware_concurrency()) - 1) {
+    for (size_t i = 0; i < size_; ++i) {
+      std::thread([this]() { Work(); }).detach();
+    }
+  }
+
+  void Work() {
+    for (;;) {
+      std::function<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        ready_.wait(lock, [this]() { return !tasks_.empty(); });
+        task = std::move(tasks_.front());
+        tasks_.pop_front();
+      }
+      task();
+    }
+  }
+
+  const size_t size_;
+  std::mutex mutex_;
+  std::condition_variable ready_;
+  std::deque<std::function<void()>> tasks_;
+};
+
+// The ranges of one call, taken in turn by the caller and the pool threads.
+// A pool thread that starts after every range is taken does nothing, so the
+// caller never waits for a busy pool.
+struct Ranges {
+  const std::function<void(size_t, size_t)>* body;
+  size_t count;
+  size_t chunk;
+  size_t size;
+  std::atomic<size_t> next{0};
+  size_t done = 0;
+  std::mutex mutex;
+  std::condition_variable finished;
+};
+
+thread_local bool in_parallel_range = false;
+
+void RunRanges(Ranges* ranges) {
+  in_parallel_range = true;
+  for (size_t i = ranges->next++; i < ranges->size; i = ranges->next++) {
+    size_t begin = i * ranges->chunk;
+    (*ranges->body)(begin, std::min(ranges->count, begin + ranges->chunk));
+    std::lock_guard<std::mutex> lock(ranges->mutex);
+    if (++ranges->done == ranges->size) {
+      ranges->finished.notify_all();
+    }
+  }
+  in_parallel_range = false;
+}
+
+}  // namespace
+
+void ParallelFor(size_t count,
+                 size_t grain,
+                 const std::function<void(size_t, size_t)>& body) {
+  if (in_parallel_range) {
+    body(0, count);
+    return;
+  }
+  ThreadPool& pool = ThreadPool::Get();
+  size_t threads = pool.size() + 1;
+  threads = std::min(threads,
+                     std::max<size_t>(1, count / std::max<size_t>(1, grain)));
+  if (threads <= 1) {
+    body(0, count);
+    return;
+  }
+
+  auto ranges = std::make_shared<Ranges>();
+  ranges->body = &body;
+  ranges->count = count;
+  ranges->chunk = (count + threads - 1) / threads;
+  ranges->size = (count + ranges->chunk - 1) / ranges->chunk;
+  for (size_t i = 1; i < ranges->size; ++i) {
+    pool.Post([ranges]() { RunRanges(ranges.get()); });
+  }
+  RunRanges(ranges.get());
+  std::unique_lock<std::mutex> lock(ranges->mutex);
+  ranges->finished.wait(
+      lock, [&ranges]() { return ranges->done == ranges->size; });
+}
+
+}  // namespace utils
+
+}  // namespace ienodejs
@@ -0,0 +1,250 @@
+#include "pose_utils.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ienodejs {
+
+namespace pose {
+
+namespace {
+
+// The offset of the vertex of the parabola through three samples, from the
+// middle one.
+float GetVertexOffset(float before, float value, float after) {
+  const float curvature = before - 2.0f * value + after;
+  if (curvature >= 0.0f) {
+    return 0.0f;
+  }
+  return std::min(std::max(0.5f * (before - after) / curvature, -0.5f), 0.5f);
+}
+
+struct Connection {
+  size_t from;
+  size_t to;
+  float score;
+};
+
+// Scores the candidate limbs between the peaks of its two keypoint types
+// and keeps the best ones that share no peak.
+std::vector<Connection> Connect(const std::vector<Keypoint>& from,
+                                const std::vector<Keypoint>& to,
+                                const float* paf_x,
+                                const float* paf_y,
+                                size_t width,
+                                size_t height,
+                                const PoseOptions& options) {
+  std::vector<Connection> candidates;
+  for (size_t i = 0; i < from.size(); ++i) {
+    for (size_t j = 0; j < to.size(); ++j) {
+      const float dx = to[j].x - from[i].x;
+      const float dy = to[j].y - from[i].y;
+      const float norm = std::sqrt(dx * dx + dy * dy);
+      if (norm < 1e-6f) {
+        continue;
+      }
+      float sum = 0.0f;
+      size_t aligned = 0;
+      for (size_t k = 0; k < options.samples; ++k) {
+        const float t = options.samples > 1
+                            ? static_cast<float>(k) / (options.samples - 1)
+                            : 0.5f;
+        const long x = std::lround(from[i].x + dx * t);
+        const long y = std::lround(from[i].y + dy * t);
+        const size_t offset =
+            std::min<size_t>(std::max(y, 0L), height - 1) * width +
+            std::min<size_t>(std::max(x, 0L), width - 1);
+        const float score = (paf_x[offset] * dx + paf_y[offset] * dy) / norm;
+        sum += score;
+        aligned += score > options.min_paf_score;
+      }
+      if (options.samples == 0 ||
+          aligned < options.success_ratio * options.samples) {
+        continue;
+      }
+      // Limbs longer than half of the height are unlikely.
+      const float score = sum / options.samples +
+                          std::min(0.5f * height / norm - 1.0f, 0.0f);
+      if (score > 0.0f) {
+        candidates.push_back({i, j, score});
+      }
+    }
+  }
+  std::stable_sort(candidates.begin(), candidates.end(),
+                   [](const Connection& a, const Connection& b) {
+                     return a.score > b.score;
+                   });
+  std::vector<bool> used_from(from.size());
+  std::vector<bool> used_to(to.size());
+  std::vector<Connection> connections;
+  for (const Connection& candidate : candidates) {
+    if (!used_from[candidate.from] && !used_to[candidate.to]) {
+      used_from[candidate.from] = true;
+      used_to[candidate.to] = true;
+      connections.push_back(candidate);
+    }
+  }
+  return connections;
+}
+
+// A pose being assembled, with the index of the peak of each keypoint type
+// or -1.
+struct Subset {
+  std::vector<long> peaks;
+  float score;
+  size_t count;
+};
+
+}  // namespace
+
+std::vector<Keypoint> FindPeaks(const float* heatmap,
+                                size_t width,
+                                size_t height,
+                                float threshold) {
+  std::vector<Keypoint> peaks;
+  std::vector<size_t> candidates(width);
+  for (size_t y = 0; y < height; ++y) {
+    const float* row = heatmap + y * width;
+    // A branch-free pass picks the cells above the threshold, so that the
+    // compiler can vectorize it; the few of them are then compared with
+    // their neighbours.
+    size_t count = 0;
+    for (size_t x = 0; x < width; ++x) {
+      candidates[count] = x;
+      count += row[x] >= threshold;
+    }
+    for (size_t c = 0; c < count; ++c) {
+      const size_t x = candidates[c];
+      const float value = row[x];
+      bool maximum = true;
+      for (long dy = -1; dy <= 1 && maximum; ++dy) {
+        const long ny = static_cast<long>(y) + dy;
+        if (ny < 0 || ny >= static_cast<long>(height)) {
+          continue;
+        }
+        for (long dx = -1; dx <= 1; ++dx) {
+          const long nx = static_cast<long>(x) + dx;
+          if ((dx == 0 && dy == 0) || nx < 0 ||
+              nx >= static_cast<long>(width)) {
+            continue;
+          }
+          const float neighbour = heatmap[ny * width + nx];
+          // Plateaus keep their first cell in scan order.
+          if (neighbour > value ||
+              (neighbour == value && (dy < 0 || (dy == 0 && dx < 0)))) {
+            maximum = false;
+            break;
+          }
+        }
+      }
+      if (!maximum) {
+        continue;
+      }
+      float px = static_cast<float>(x);
+      float py = static_cast<float>(y);
+      if (x > 0 && x + 1 < width) {
+        px += GetVertexOffset(row[x - 1], value, row[x + 1]);
+      }
+      if (y > 0 && y + 1 < height) {
+        py += GetVertexOffset(row[x - width], value, row[x + width]);
+      }
+      peaks.push_back({px, py, value});
+    }
+  }
+  return peaks;
+}
+
+std::vector<Pose> GroupPoses(const std::vector<std::vector<Keypoint>>& peaks,
+                             const float* pafs,
+                             size_t width,
+                             size_t height,
+                             const PoseOptions& options) {
+  const size_t keypoints = peaks.size();
+  const size_t area = width * height;
+  std::vector<Subset> subsets;
+  for (const Limb& limb : options.limbs) {
+    const std::vector<Keypoint>& from = peaks[limb.from];
+    const std::vector<Keypoint>& to = peaks[limb.to];
+    std::vector<Connection> connections =
+        Connect(from, to, pafs + limb.paf_x * area, pafs + limb.paf_y * area,
+                width, height, options);
+    for (const Connection& connection : connections) {
+      const long a = static_cast<long>(connection.from);
+      const long b = static_cast<long>(connection.to);
+      Subset* with_from = nullptr;
+      Subset* with_to = nullptr;
+      for (Subset& subset : subsets) {
+        if (subset.peaks[limb.from] == a) {
+          with_from = &subset;
+        }
+        if (subset.peaks[limb.to] == b) {
+          with_to = &subset;
+        }
+      }
+      if (with_from && with_to) {
+        if (with_from == with_to) {
+          continue;
+        }
+        // Two parts of one pose meet; they merge unless they overlap.
+        bool overlap = false;
+        for (size_t k = 0; k < keypoints; ++k) {
+          overlap |= with_from->peaks[k] >= 0 && with_to->peaks[k] >= 0;
+        }
+        if (overlap) {
+          continue;
+        }
+        for (size_t k = 0; k < keypoints; ++k) {
+          if (with_to->peaks[k] >= 0) {
+            with_from->peaks[k] = with_to->peaks[k];
+          }
+        }
+        with_from->score += with_to->score + connection.score;
+        with_from->count += with_to->count;
+        subsets.erase(subsets.begin() + (with_to - subsets.data()));
+      } else if (with_from) {
+        if (with_from->peaks[limb.to] < 0) {
+          with_from->peaks[limb.to] = b;
+          with_from->score += to[b].score + connection.score;
+          ++with_from->count;
+        }
+      } else if (with_to) {
+        if (with_to->peaks[limb.from] < 0) {
+          with_to->peaks[limb.from] = a;
+          with_to->score += from[a].score + connection.score;
+          ++with_to->count;
+        }
+      } else {
+        Subset subset = {std::vector<long>(keypoints, -1),
+                         from[a].score + to[b].score + connection.score, 2};
+        subset.peaks[limb.from] = a;
+        subset.peaks[limb.to] = b;
+        subsets.push_back(subset);
+      }
+    }
+  }
+
+  std::vector<Pose> poses;
+  for (const Subset& subset : subsets) {
+    if (subset.count < options.min_keypoints ||
+        subset.score / subset.count < options.min_mean_score) {
+      continue;
+    }
+    Pose pose = {std::vector<Keypoint>(keypoints, {-1.0f, -1.0f, 0.0f}),
+                 subset.score};
+    for (size_t k = 0; k < keypoints; ++k) {
+      if (subset.peaks[k] >= 0) {
+        pose.keypoints[k] = peaks[k][subset.peaks[k]];
+      }
+    }
+    poses.push_back(pose);
+  }
+  std::stable_sort(poses.begin(), poses.end(),
+                   [](const Pose& a, const Pose& b) {
+                     return a.score > b.score;
+                   });
+  return poses;
+}
+
+}  // namespace pose
+
+}  // namespace ienodejs
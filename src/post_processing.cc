@@ -0,0 +1,913 @@
+#include "post_processing.h"
+#include "blob.h"
+#include "classification_utils.h"
+#include "detection_utils.h"
+#include "float_tensor.h"
+#include "pose_utils.h"
+#include "segmentation_utils.h"
+#include "utils.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "inference_engine.hpp"
+
+using namespace Napi;
+
+namespace ie = InferenceEngine;
+
+namespace ienodejs {
+
+namespace {
+
+using detection::Detection;
+
+// Points |data| at the elements of a Float32Array. Returns false for any
+// other value.
+bool GetFloats(const Napi::Value& value, const float** data, size_t* length) {
+  if (!value.IsTypedArray() ||
+      value.As<Napi::TypedArray>().TypedArrayType() != napi_float32_array) {
+    return false;
+  }
+  Napi::Float32Array array = value.As<Napi::Float32Array>();
+  *data = static_cast<const float*>(utils::GetTypedArrayData(array));
+  *length = array.ElementLength();
+  return true;
+}
+
+// Reads an array of numbers. Returns false for any other value.
+bool GetNumbers(const Napi::Value& value, std::vector<float>* numbers) {
+  if (!value.IsArray()) {
+    return false;
+  }
+  Napi::Array array = value.As<Napi::Array>();
+  numbers->clear();
+  for (uint32_t i = 0; i < array.Length(); ++i) {
+    Napi::Value number = array.Get(i);
+    if (!number.IsNumber()) {
+      return false;
+    }
+    numbers->push_back(number.ToNumber().FloatValue());
+  }
+  return true;
+}
+
+Detection ReadDetection(const float* row) {
+  return {row[0], row[1], row[2], row[3], row[4], row[5], row[6]};
+}
+
+Napi::Float32Array CreateDetectionArray(
+    const Napi::Env& env,
+    const std::vector<Detection>& detections) {
+  Napi::Float32Array array = Napi::Float32Array::New(
+      env, detections.size() * detection::kDetectionSize);
+  float* data = array.Data();
+  for (const Detection& box : detections) {
+    const float row[] = {box.image_id, box.label, box.confidence, box.x1,
+                         box.y1,       box.x2,    box.y2};
+    data = std::copy(row, row + detection::kDetectionSize, data);
+  }
+  return array;
+}
+
+// The fields of an ImageTransform object that map input boxes to the source.
+struct TileTransform {
+  double scale_x;
+  double scale_y;
+  double pad_x;
+  double pad_y;
+  double source_width;
+  double source_height;
+  double input_width;
+  double input_height;
+};
+
+bool GetTileTransform(const Napi::Value& value, TileTransform* transform) {
+  if (!value.IsObject()) {
+    return false;
+  }
+  Napi::Object object = value.As<Napi::Object>();
+  const char* keys[] = {"scaleX",     "scaleY",       "padX",
+                        "padY",       "sourceWidth",  "sourceHeight",
+                        "inputWidth", "inputHeight"};
+  double* fields[] = {&transform->scale_x,      &transform->scale_y,
+                      &transform->pad_x,        &transform->pad_y,
+                      &transform->source_width, &transform->source_height,
+                      &transform->input_width,  &transform->input_height};
+  for (size_t i = 0; i < 8; ++i) {
+    Napi::Value field = object.Get(keys[i]);
+    if (!field.IsNumber()) {
+      return false;
+    }
+    *fields[i] = field.ToNumber().DoubleValue();
+  }
+  return transform->scale_x > 0 && transform->scale_y > 0;
+}
+
+// Maps a point in input coordinates to the source image of |transform|.
+void MapPointToSource(const TileTransform& transform,
+                      bool normalized,
+                      float* x,
+                      float* y) {
+  const double sx = normalized ? transform.input_width : 1.0;
+  const double sy = normalized ? transform.input_height : 1.0;
+  auto map = [](double value, double scale, double pad, double stretch,
+                double max) {
+    double mapped = (value * stretch - pad) / scale;
+    return static_cast<float>(std::min(std::max(mapped, 0.0), max));
+  };
+  *x = map(*x, transform.scale_x, transform.pad_x, sx,
+           transform.source_width);
+  *y = map(*y, transform.scale_y, transform.pad_y, sy,
+           transform.source_height);
+}
+
+// Maps a box in input coordinates to the source image of |transform|.
+void MapToSource(const TileTransform& transform,
+                 bool normalized,
+                 Detection* box) {
+  MapPointToSource(transform, normalized, &box->x1, &box->y1);
+  MapPointToSource(transform, normalized, &box->x2, &box->y2);
+}
+
+// The skeleton of the 18 COCO keypoints of OpenPose models such as
+// human-pose-estimation-0001: the keypoints of each limb and the channels of
+// its part affinity field.
+const size_t kCocoLimbs[][4] = {
+    {1, 2, 12, 13},  {1, 5, 20, 21},   {2, 3, 14, 15},   {3, 4, 16, 17},
+    {5, 6, 22, 23},  {6, 7, 24, 25},   {1, 8, 0, 1},     {8, 9, 2, 3},
+    {9, 10, 4, 5},   {1, 11, 6, 7},    {11, 12, 8, 9},   {12, 13, 10, 11},
+    {1, 0, 28, 29},  {0, 14, 30, 31},  {14, 16, 34, 35}, {0, 15, 32, 33},
+    {15, 17, 36, 37}, {2, 16, 18, 19}, {5, 17, 26, 27}};
+const size_t kCocoKeypoints = 18;
+
+}  // namespace
+
+void PostProcessing::Init(const Napi::Env& env, Napi::Object exports) {
+  Napi::Object object = Napi::Object::New(env);
+  object.Set("topK", Napi::Function::New(env, TopK));
+  object.Set("decodeSSD", Napi::Function::New(env, DecodeSSD));
+  object.Set("decodeYolo", Napi::Function::New(env, DecodeYolo));
+  object.Set("segmentationMask", Napi::Function::New(env, SegmentationMask));
+  object.Set("decodePose", Napi::Function::New(env, DecodePose));
+  object.Set("nms", Napi::Function::New(env, Nms));
+  object.Set("mergeTiledDetections",
+             Napi::Function::New(env, MergeTiledDetections));
+  exports.Set("postProcessing", object);
+}
+
+std::string PostProcessing::GetNmsOptions(const Napi::Object& options,
+                                          detection::NmsOptions* nms) {
+  if (options.Has("iouThreshold")) {
+    if (!options.Get("iouThreshold").IsNumber()) {
+      return "iouThreshold should be a number";
+    }
+    nms->threshold = options.Get("iouThreshold").ToNumber().FloatValue();
+  }
+  if (options.Has("metric")) {
+    std::string metric = options.Get("metric").ToString();
+    if (metric == "iou") {
+      nms->metric = detection::OverlapMetric::IOU;
+    } else if (metric == "ios") {
+      nms->metric = detection::OverlapMetric::IOS;
+    } else {
+      return "Unsupported overlap metric";
+    }
+  }
+  if (options.Has("classAgnostic")) {
+    nms->class_agnostic = options.Get("classAgnostic").ToBoolean();
+  }
+  if (options.Has("maxDetections")) {
+    if (!options.Get("maxDetections").IsNumber()) {
+      return "maxDetections should be a number";
+    }
+    nms->max_detections =
+        options.Get("maxDetections").ToNumber().Uint32Value();
+  }
+  return std::string();
+}
+
+Napi::Value PostProcessing::TopK(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  if (info.Length() < 2 || info.Length() > 3) {
+    Napi::TypeError::New(env, "Wrong number of arguments")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  if (!info[1].IsNumber() || (info.Length() == 3 && !info[2].IsObject())) {
+    Napi::TypeError::New(env, "Wrong type of arguments")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  bool softmax = false;
+  if (info.Length() == 3 && info[2].ToObject().Has("softmax")) {
+    softmax = info[2].ToObject().Get("softmax").ToBoolean();
+  }
+
+  ie::Blob::Ptr blob;
+  if (!Blob::GetActual(env, info[0], &blob)) {
+    return env.Null();
+  }
+  FloatTensor tensor;
+  std::string message = tensor.Init(info[0], blob);
+  if (!message.empty()) {
+    Napi::TypeError::New(env, message).ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  // The first dimension is the batch; each item is ranked on its own.
+  const size_t batch = tensor.dims().empty() ? 1 : tensor.dims()[0];
+  const size_t count = batch > 0 ? tensor.size() / batch : 0;
+  const size_t requested = info[1].ToNumber().Uint32Value();
+  if (requested == 0 || count == 0) {
+    Napi::RangeError::New(env, "k should be a positive number")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  const size_t k = std::min(requested, count);
+
+  Napi::Int32Array indices = Napi::Int32Array::New(env, batch * k);
+  Napi::Float32Array scores = Napi::Float32Array::New(env, batch * k);
+  for (size_t i = 0; i < batch; ++i) {
+    classification::TopK(tensor.data() + i * count, count, k, softmax,
+                         indices.Data() + i * k, scores.Data() + i * k);
+  }
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("indices", indices);
+  result.Set("scores", scores);
+  return result;
+}
+
+Napi::Value PostProcessing::DecodeSSD(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  if (info.Length() < 1 || info.Length() > 2) {
+    Napi::TypeError::New(env, "Wrong number of arguments")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  if (info.Length() == 2 && !info[1].IsObject()) {
+    Napi::TypeError::New(env, "Wrong type of arguments")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  float threshold = 0.5f;
+  bool nms = false;
+  detection::NmsOptions nms_options;
+  bool has_transform = false;
+  TileTransform transform;
+  if (info.Length() == 2) {
+    Napi::Object options = info[1].ToObject();
+    if (options.Has("threshold")) {
+      if (!options.Get("threshold").IsNumber()) {
+        Napi::TypeError::New(env, "threshold should be a number")
+            .ThrowAsJavaScriptException();
+        return env.Null();
+      }
+      threshold = options.Get("threshold").ToNumber().FloatValue();
+    }
+    if (options.Has("nms")) {
+      nms = options.Get("nms").ToBoolean();
+    }
+    std::string message = GetNmsOptions(options, &nms_options);
+    if (!message.empty()) {
+      Napi::TypeError::New(env, message).ThrowAsJavaScriptException();
+      return env.Null();
+    }
+    if (options.Has("transform")) {
+      if (!GetTileTransform(options.Get("transform"), &transform)) {
+        Napi::TypeError::New(env, "Invalid transform")
+            .ThrowAsJavaScriptException();
+        return env.Null();
+      }
+      has_transform = true;
+    }
+  }
+
+  ie::Blob::Ptr blob;
+  if (!Blob::GetActual(env, info[0], &blob)) {
+    return env.Null();
+  }
+  FloatTensor tensor;
+  std::string message = tensor.Init(info[0], blob);
+  if (!message.empty()) {
+    Napi::TypeError::New(env, message).ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  if (tensor.size() % detection::kDetectionSize != 0) {
+    Napi::RangeError::New(env, "The detections are not rows of 7 values")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  std::vector<Detection> detections;
+  try {
+    detections = detection::DecodeDetectionOutput(
+        tensor.data(), tensor.size() / detection::kDetectionSize, threshold,
+        nms, nms_options);
+  } catch (const std::exception& error) {
+    Napi::RangeError::New(env, error.what()).ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  if (has_transform) {
+    for (Detection& box : detections) {
+      MapToSource(transform, true, &box);
+    }
+  }
+  return CreateDetectionArray(env, detections);
+}
+
+Napi::Value PostProcessing::DecodeYolo(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  if (info.Length() != 2) {
+    Napi::TypeError::New(env, "Wrong number of arguments")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  if (!info[0].IsArray() || !info[1].IsObject()) {
+    Napi::TypeError::New(env, "Wrong type of arguments")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  Napi::Array outputs = info[0].As<Napi::Array>();
+  Napi::Object config = info[1].ToObject();
+
+  detection::YoloOptions options;
+  bool nms = true;
+  detection::NmsOptions nms_options;
+  bool has_transform = false;
+  TileTransform transform;
+  std::vector<float> anchors;
+  if (!config.Get("classes").IsNumber() ||
+      !GetNumbers(config.Get("anchors"), &anchors) || anchors.empty() ||
+      anchors.size() % 2 != 0) {
+    Napi::TypeError::New(env, "classes and anchor pairs are required")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  options.classes = config.Get("classes").ToNumber().Uint32Value();
+  const char* keys[] = {"coords", "inputWidth", "inputHeight", "threshold"};
+  for (const char* key : keys) {
+    if (config.Has(key) && !config.Get(key).IsNumber()) {
+      Napi::TypeError::New(env, std::string(key) + " should be a number")
+          .ThrowAsJavaScriptException();
+      return env.Null();
+    }
+  }
+  if (config.Has("coords")) {
+    options.coords = config.Get("coords").ToNumber().Uint32Value();
+  }
+  if (config.Has("inputWidth")) {
+    options.input_width = config.Get("inputWidth").ToNumber().FloatValue();
+  }
+  if (config.Has("inputHeight")) {
+    options.input_height = config.Get("inputHeight").ToNumber().FloatValue();
+  }
+  if (config.Has("threshold")) {
+    options.threshold = config.Get("threshold").ToNumber().FloatValue();
+  }
+  if (options.coords < 4 || options.input_width <= 0 ||
+      options.input_height <= 0) {
+    Napi::RangeError::New(env, "Invalid coords or input size")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  if (config.Has("sigmoid")) {
+    options.sigmoid = config.Get("sigmoid").ToBoolean();
+  }
+  if (config.Has("nms")) {
+    nms = config.Get("nms").ToBoolean();
+  }
+  std::string message = GetNmsOptions(config, &nms_options);
+  if (!message.empty()) {
+    Napi::TypeError::New(env, message).ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  if (config.Has("transform")) {
+    if (!GetTileTransform(config.Get("transform"), &transform)) {
+      Napi::TypeError::New(env, "Invalid transform")
+          .ThrowAsJavaScriptException();
+      return env.Null();
+    }
+    has_transform = true;
+  }
+  Napi::Array masks;
+  if (config.Has("masks")) {
+    if (!config.Get("masks").IsArray() ||
+        config.Get("masks").As<Napi::Array>().Length() !=
+            outputs.Length()) {
+      Napi::TypeError::New(env, "masks should have an array per output")
+          .ThrowAsJavaScriptException();
+      return env.Null();
+    }
+    masks = config.Get("masks").As<Napi::Array>();
+  }
+
+  // The tensors keep the outputs mapped until the scales are decoded.
+  std::vector<std::unique_ptr<FloatTensor>> tensors;
+  std::vector<detection::YoloScale> scales;
+  const size_t entries = options.coords + 1 + options.classes;
+  for (uint32_t i = 0; i < outputs.Length(); ++i) {
+    ie::Blob::Ptr blob;
+    if (!Blob::GetActual(env, outputs.Get(i), &blob)) {
+      return env.Null();
+    }
+    // A bare Float32Array has no spatial dims.
+    if (!blob && outputs.Get(i).IsTypedArray()) {
+      Napi::TypeError::New(env, "The outputs should be Blobs or tensors")
+          .ThrowAsJavaScriptException();
+      return env.Null();
+    }
+    tensors.emplace_back(new FloatTensor());
+    message = tensors.back()->Init(outputs.Get(i), blob);
+    if (!message.empty()) {
+      Napi::TypeError::New(env, message).ThrowAsJavaScriptException();
+      return env.Null();
+    }
+    const ie::SizeVector& dims = tensors.back()->dims();
+    if (dims.size() != 4) {
+      Napi::RangeError::New(env, "The outputs should be 4D")
+          .ThrowAsJavaScriptException();
+      return env.Null();
+    }
+
+    // The anchors of the scale are the masked ones, or all of them.
+    detection::YoloScale scale = {tensors.back()->data(), dims[0], dims[1],
+                                  dims[2], dims[3], {}};
+    std::vector<float> mask;
+    if (!masks.IsEmpty()) {
+      if (!GetNumbers(masks.Get(i), &mask)) {
+        Napi::TypeError::New(env, "Invalid mask")
+            .ThrowAsJavaScriptException();
+        return env.Null();
+      }
+    } else {
+      for (size_t a = 0; a < anchors.size() / 2; ++a) {
+        mask.push_back(static_cast<float>(a));
+      }
+    }
+    for (float index : mask) {
+      const size_t a = static_cast<size_t>(index);
+      if (index < 0 || a >= anchors.size() / 2) {
+        Napi::RangeError::New(env, "The mask is out of the anchors")
+            .ThrowAsJavaScriptException();
+        return env.Null();
+      }
+      scale.anchors.push_back(anchors[2 * a]);
+      scale.anchors.push_back(anchors[2 * a + 1]);
+    }
+    if (scale.channels != mask.size() * entries) {
+      Napi::RangeError::New(
+          env, "The channels of the output do not match its anchors")
+          .ThrowAsJavaScriptException();
+      return env.Null();
+    }
+    scales.push_back(scale);
+  }
+
+  std::vector<Detection> detections =
+      detection::DecodeYolo(scales, options, nms, nms_options);
+  if (has_transform) {
+    for (Detection& box : detections) {
+      MapToSource(transform, true, &box);
+    }
+  }
+  return CreateDetectionArray(env, detections);
+}
+
+Napi::Value PostProcessing::SegmentationMask(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  if (info.Length() < 1 || info.Length() > 2) {
+    Napi::TypeError::New(env, "Wrong number of arguments")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  if (info.Length() == 2 && !info[1].IsObject()) {
+    Napi::TypeError::New(env, "Wrong type of arguments")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  ie::Blob::Ptr blob;
+  if (!Blob::GetActual(env, info[0], &blob)) {
+    return env.Null();
+  }
+  if (!blob) {
+    Napi::TypeError::New(env, "Wrong type of arguments")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  FloatTensor tensor;
+  std::string message = tensor.Init(info[0], blob);
+  if (!message.empty()) {
+    Napi::TypeError::New(env, message).ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  // [N, C, H, W], or [C, H, W] for one image.
+  ie::SizeVector dims = tensor.dims();
+  if (dims.size() == 3) {
+    dims.insert(dims.begin(), 1);
+  }
+  if (dims.size() != 4) {
+    Napi::RangeError::New(env, "The scores should be 3D or 4D")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  const size_t batch = dims[0];
+  const size_t channels = dims[1];
+  const size_t height = dims[2];
+  const size_t width = dims[3];
+  if (channels == 0 || channels > 256) {
+    Napi::RangeError::New(env, "Only 1 to 256 classes fit in a Uint8 mask")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  size_t output_width = width;
+  size_t output_height = height;
+  bool bilinear = false;
+  Napi::Value output;
+  if (info.Length() == 2) {
+    Napi::Object options = info[1].ToObject();
+    if (options.Has("outputSize")) {
+      Napi::Value size = options.Get("outputSize");
+      if (!size.IsObject() || !size.ToObject().Get("width").IsNumber() ||
+          !size.ToObject().Get("height").IsNumber()) {
+        Napi::TypeError::New(env, "outputSize should be {width, height}")
+            .ThrowAsJavaScriptException();
+        return env.Null();
+      }
+      output_width = size.ToObject().Get("width").ToNumber().Uint32Value();
+      output_height = size.ToObject().Get("height").ToNumber().Uint32Value();
+      if (output_width == 0 || output_height == 0) {
+        Napi::RangeError::New(env, "The output size is empty")
+            .ThrowAsJavaScriptException();
+        return env.Null();
+      }
+    }
+    if (options.Has("resize")) {
+      std::string resize = options.Get("resize").ToString();
+      if (resize != "nearest" && resize != "bilinear") {
+        Napi::TypeError::New(env, "Unsupported resize")
+            .ThrowAsJavaScriptException();
+        return env.Null();
+      }
+      bilinear = resize == "bilinear";
+    }
+    if (options.Has("output")) {
+      output = options.Get("output");
+      if (!output.IsTypedArray() ||
+          output.As<Napi::TypedArray>().TypedArrayType() !=
+              napi_uint8_array) {
+        Napi::TypeError::New(env, "output should be a Uint8Array")
+            .ThrowAsJavaScriptException();
+        return env.Null();
+      }
+    }
+  }
+
+  const size_t area = width * height;
+  const size_t output_area = output_width * output_height;
+  Napi::Uint8Array mask;
+  if (output.IsEmpty()) {
+    mask = Napi::Uint8Array::New(env, batch * output_area);
+  } else {
+    mask = output.As<Napi::Uint8Array>();
+    if (mask.ElementLength() < batch * output_area) {
+      Napi::RangeError::New(env, "The output is too short")
+          .ThrowAsJavaScriptException();
+      return env.Null();
+    }
+  }
+
+  uint8_t* data = static_cast<uint8_t*>(utils::GetTypedArrayData(mask));
+  const bool resize = output_width != width || output_height != height;
+  std::vector<uint8_t> labels(resize ? area : 0);
+  for (size_t b = 0; b < batch; ++b) {
+    const float* scores = tensor.data() + b * channels * area;
+    uint8_t* out = data + b * output_area;
+    // A single plane holds labels, which are not interpolated.
+    if (resize && bilinear && channels > 1) {
+      segmentation::ArgMaxBilinear(scores, channels, width, height, out,
+                                   output_width, output_height);
+    } else if (resize) {
+      segmentation::ArgMax(scores, channels, width, height, labels.data());
+      segmentation::ResizeNearest(labels.data(), width, height, out,
+                                  output_width, output_height);
+    } else {
+      segmentation::ArgMax(scores, channels, width, height, out);
+    }
+  }
+  return mask;
+}
+
+Napi::Value PostProcessing::DecodePose(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  if (info.Length() < 2 || info.Length() > 3) {
+    Napi::TypeError::New(env, "Wrong number of arguments")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  if (info.Length() == 3 && !info[2].IsObject()) {
+    Napi::TypeError::New(env, "Wrong type of arguments")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  ie::Blob::Ptr heatmap_blob;
+  ie::Blob::Ptr paf_blob;
+  if (!Blob::GetActual(env, info[0], &heatmap_blob) ||
+      !Blob::GetActual(env, info[1], &paf_blob)) {
+    return env.Null();
+  }
+  // A bare Float32Array has no spatial dims.
+  if ((!heatmap_blob && info[0].IsTypedArray()) ||
+      (!paf_blob && info[1].IsTypedArray())) {
+    Napi::TypeError::New(env, "Wrong type of arguments")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  FloatTensor heatmaps;
+  FloatTensor pafs;
+  std::string message = heatmaps.Init(info[0], heatmap_blob);
+  if (message.empty()) {
+    message = pafs.Init(info[1], paf_blob);
+  }
+  if (!message.empty()) {
+    Napi::TypeError::New(env, message).ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  const ie::SizeVector& dims = heatmaps.dims();
+  const ie::SizeVector& paf_dims = pafs.dims();
+  if (dims.size() != 4 || paf_dims.size() != 4 || dims[0] != paf_dims[0] ||
+      dims[2] != paf_dims[2] || dims[3] != paf_dims[3]) {
+    Napi::RangeError::New(
+        env, "The heatmaps and fields should be [N, C, H, W] of one size")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  const size_t batch = dims[0];
+  const size_t height = dims[2];
+  const size_t width = dims[3];
+
+  pose::PoseOptions options;
+  size_t keypoints = kCocoKeypoints;
+  bool has_transform = false;
+  TileTransform transform;
+  for (const size_t* limb : kCocoLimbs) {
+    options.limbs.push_back({limb[0], limb[1], limb[2], limb[3]});
+  }
+  if (info.Length() == 3) {
+    Napi::Object config = info[2].ToObject();
+    const char* keys[] = {"keypoints", "threshold", "minKeypoints",
+                          "minScore"};
+    for (const char* key : keys) {
+      if (config.Has(key) && !config.Get(key).IsNumber()) {
+        Napi::TypeError::New(env, std::string(key) + " should be a number")
+            .ThrowAsJavaScriptException();
+        return env.Null();
+      }
+    }
+    if (config.Has("keypoints")) {
+      keypoints = config.Get("keypoints").ToNumber().Uint32Value();
+    }
+    if (config.Has("threshold")) {
+      options.threshold = config.Get("threshold").ToNumber().FloatValue();
+    }
+    if (config.Has("minKeypoints")) {
+      options.min_keypoints =
+          config.Get("minKeypoints").ToNumber().Uint32Value();
+    }
+    if (config.Has("minScore")) {
+      options.min_mean_score = config.Get("minScore").ToNumber().FloatValue();
+    }
+    if (config.Has("limbs")) {
+      Napi::Value limbs = config.Get("limbs");
+      if (!limbs.IsArray()) {
+        Napi::TypeError::New(env, "limbs should be an array")
+            .ThrowAsJavaScriptException();
+        return env.Null();
+      }
+      options.limbs.clear();
+      Napi::Array array = limbs.As<Napi::Array>();
+      for (uint32_t i = 0; i < array.Length(); ++i) {
+        std::vector<float> limb;
+        if (!GetNumbers(array.Get(i), &limb) || limb.size() != 4 ||
+            *std::min_element(limb.begin(), limb.end()) < 0) {
+          Napi::TypeError::New(env,
+                               "A limb should be [from, to, pafX, pafY]")
+              .ThrowAsJavaScriptException();
+          return env.Null();
+        }
+        options.limbs.push_back(
+            {static_cast<size_t>(limb[0]), static_cast<size_t>(limb[1]),
+             static_cast<size_t>(limb[2]), static_cast<size_t>(limb[3])});
+      }
+    }
+    if (config.Has("transform")) {
+      if (!GetTileTransform(config.Get("transform"), &transform)) {
+        Napi::TypeError::New(env, "Invalid transform")
+            .ThrowAsJavaScriptException();
+        return env.Null();
+      }
+      has_transform = true;
+    }
+  }
+  if (keypoints == 0 || keypoints > dims[1]) {
+    Napi::RangeError::New(env, "The heatmaps have too few channels")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  for (const pose::Limb& limb : options.limbs) {
+    if (limb.from >= keypoints || limb.to >= keypoints ||
+        limb.paf_x >= paf_dims[1] || limb.paf_y >= paf_dims[1]) {
+      Napi::RangeError::New(env, "A limb is out of the keypoints or fields")
+          .ThrowAsJavaScriptException();
+      return env.Null();
+    }
+  }
+
+  const size_t area = width * height;
+  std::vector<pose::Pose> poses;
+  std::vector<int32_t> image_ids;
+  for (size_t b = 0; b < batch; ++b) {
+    std::vector<std::vector<pose::Keypoint>> peaks;
+    for (size_t k = 0; k < keypoints; ++k) {
+      peaks.push_back(pose::FindPeaks(
+          heatmaps.data() + (b * dims[1] + k) * area, width, height,
+          options.threshold));
+    }
+    std::vector<pose::Pose> image_poses = pose::GroupPoses(
+        peaks, pafs.data() + b * paf_dims[1] * area, width, height, options);
+    poses.insert(poses.end(), image_poses.begin(), image_poses.end());
+    image_ids.resize(poses.size(), static_cast<int32_t>(b));
+  }
+
+  // Each keypoint is [x, y, score], in fractions of the input size or in
+  // source pixels; missing ones are [-1, -1, 0].
+  Napi::Float32Array points =
+      Napi::Float32Array::New(env, poses.size() * keypoints * 3);
+  Napi::Float32Array scores = Napi::Float32Array::New(env, poses.size());
+  Napi::Int32Array ids = Napi::Int32Array::New(env, poses.size());
+  float* point = points.Data();
+  for (size_t i = 0; i < poses.size(); ++i) {
+    for (const pose::Keypoint& keypoint : poses[i].keypoints) {
+      float x = keypoint.x;
+      float y = keypoint.y;
+      if (keypoint.score > 0.0f) {
+        x = (x + 0.5f) / width;
+        y = (y + 0.5f) / height;
+        if (has_transform) {
+          MapPointToSource(transform, true, &x, &y);
+        }
+      }
+      *point++ = x;
+      *point++ = y;
+      *point++ = keypoint.score;
+    }
+    scores[i] = poses[i].score;
+    ids[i] = image_ids[i];
+  }
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("keypoints", points);
+  result.Set("scores", scores);
+  result.Set("imageIds", ids);
+  return result;
+}
+
+Napi::Value PostProcessing::Nms(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  if (info.Length() < 1 || info.Length() > 2) {
+    Napi::TypeError::New(env, "Wrong number of arguments")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  const float* data = nullptr;
+  size_t length = 0;
+  if (!GetFloats(info[0], &data, &length) ||
+      (info.Length() == 2 && !info[1].IsObject())) {
+    Napi::TypeError::New(env, "Wrong type of arguments")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  if (length % detection::kDetectionSize != 0) {
+    Napi::RangeError::New(env, "The detections are not rows of 7 values")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  detection::NmsOptions nms;
+  if (info.Length() == 2) {
+    std::string message = GetNmsOptions(info[1].ToObject(), &nms);
+    if (!message.empty()) {
+      Napi::TypeError::New(env, message).ThrowAsJavaScriptException();
+      return env.Null();
+    }
+  }
+
+  std::vector<Detection> detections;
+  for (size_t i = 0; i < length; i += detection::kDetectionSize) {
+    detections.push_back(ReadDetection(data + i));
+  }
+  return CreateDetectionArray(env,
+                              detection::NonMaxSuppression(detections, nms));
+}
+
+Napi::Value PostProcessing::MergeTiledDetections(
+    const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  if (info.Length() < 2 || info.Length() > 3) {
+    Napi::TypeError::New(env, "Wrong number of arguments")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  if (!info[0].IsArray() || !info[1].IsArray() ||
+      (info.Length() == 3 && !info[2].IsObject())) {
+    Napi::TypeError::New(env, "Wrong type of arguments")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  Napi::Array outputs = info[0].As<Napi::Array>();
+  Napi::Array transforms = info[1].As<Napi::Array>();
+  if (outputs.Length() != transforms.Length()) {
+    Napi::RangeError::New(env, "Each output needs its tile transforms")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  float threshold = 0.5f;
+  bool normalized = true;
+  detection::NmsOptions nms;
+  if (info.Length() == 3) {
+    Napi::Object options = info[2].ToObject();
+    if (options.Has("threshold")) {
+      if (!options.Get("threshold").IsNumber()) {
+        Napi::TypeError::New(env, "threshold should be a number")
+            .ThrowAsJavaScriptException();
+        return env.Null();
+      }
+      threshold = options.Get("threshold").ToNumber().FloatValue();
+    }
+    if (options.Has("normalized")) {
+      normalized = options.Get("normalized").ToBoolean();
+    }
+    std::string message = GetNmsOptions(options, &nms);
+    if (!message.empty()) {
+      Napi::TypeError::New(env, message).ThrowAsJavaScriptException();
+      return env.Null();
+    }
+  }
+
+  std::vector<Detection> detections;
+  for (uint32_t i = 0; i < outputs.Length(); ++i) {
+    const float* data = nullptr;
+    size_t length = 0;
+    if (!GetFloats(outputs.Get(i), &data, &length)) {
+      Napi::TypeError::New(env, "The outputs should be Float32Arrays")
+          .ThrowAsJavaScriptException();
+      return env.Null();
+    }
+    // One transform per batch item, indexed by the image id of the rows.
+    std::vector<TileTransform> tiles;
+    Napi::Value value = transforms.Get(i);
+    std::vector<Napi::Value> values;
+    if (value.IsArray()) {
+      Napi::Array array = value.As<Napi::Array>();
+      for (uint32_t j = 0; j < array.Length(); ++j) {
+        values.push_back(array.Get(j));
+      }
+    } else {
+      values.push_back(value);
+    }
+    for (auto& element : values) {
+      TileTransform tile;
+      if (!GetTileTransform(element, &tile)) {
+        Napi::TypeError::New(env, "Invalid tile transform")
+            .ThrowAsJavaScriptException();
+        return env.Null();
+      }
+      tiles.push_back(tile);
+    }
+
+    for (size_t k = 0; k + detection::kDetectionSize <= length;
+         k += detection::kDetectionSize) {
+      Detection box = ReadDetection(data + k);
+      // DetectionOutput ends the valid rows with a negative image id.
+      if (box.image_id < 0) {
+        break;
+      }
+      // Batch items past the last tile hold no tile of this frame.
+      size_t image_id = static_cast<size_t>(box.image_id);
+      if (image_id >= tiles.size() || box.confidence < threshold) {
+        continue;
+      }
+      MapToSource(tiles[image_id], normalized, &box);
+      box.image_id = 0;
+      detections.push_back(box);
+    }
+  }
+  return CreateDetectionArray(env,
+                              detection::NonMaxSuppression(detections, nms));
+}
+
+}  // namespace ienodejs
@@ -162,45 +162,12 @@ void PreProcessChannel::SetMeanData(const Napi::CallbackInfo& info,
     ie::Precision precision = utils::GetPrecisionByName(precisionString);
     ie::Layout layout = utils::GetLayoutByName(layoutString);
     ie::TensorDesc tensor(precision, dimsVector, layout);
-    ie::Blob::Ptr meanDataBlob;
 
     switch (precision) {
       case ie::Precision::FP32:
-        if ((meanDataLength / sizeof(float)) != dimsProduct) {
-          Napi::TypeError::New(env, "Dims does not match the data")
-              .ThrowAsJavaScriptException();
-          return;
-        }
-        meanDataBlob = ie::make_shared_blob<float>(
-            tensor, reinterpret_cast<float*>(malloc(meanDataLength)),
-            meanDataLength);
-        memcpy(ie::as<ie::MemoryBlob>(meanDataBlob)->wmap(), meanDataBuffer,
-               meanDataLength);
-        break;
       case ie::Precision::FP16:
       case ie::Precision::I16:
-        if ((meanDataLength / sizeof(int16_t)) != dimsProduct) {
-          Napi::TypeError::New(env, "Dims does not match the data")
-              .ThrowAsJavaScriptException();
-          return;
-        }
-        meanDataBlob = ie::make_shared_blob<int16_t>(
-            tensor, reinterpret_cast<int16_t*>(malloc(meanDataLength)),
-            meanDataLength);
-        memcpy(ie::as<ie::MemoryBlob>(meanDataBlob)->wmap(), meanDataBuffer,
-               meanDataLength);
-        break;
       case ie::Precision::U8:
-        if ((meanDataLength / sizeof(uint8_t)) != dimsProduct) {
-          Napi::TypeError::New(env, "Dims does not match the data")
-              .ThrowAsJavaScriptException();
-          return;
-        }
-        meanDataBlob = ie::make_shared_blob<uint8_t>(
-            tensor, reinterpret_cast<uint8_t*>(malloc(meanDataLength)),
-            meanDataLength);
-        memcpy(ie::as<ie::MemoryBlob>(meanDataBlob)->wmap(), meanDataBuffer,
-               meanDataLength);
         break;
       default:
         Napi::TypeError::New(env,
@@ -209,7 +176,19 @@ void PreProcessChannel::SetMeanData(const Napi::CallbackInfo& info,
             .ThrowAsJavaScriptException();
         return;
     }
-    meanDataBlob->allocate();
+    if ((meanDataLength / precision.size()) != dimsProduct) {
+      Napi::TypeError::New(env, "Dims does not match the data")
+          .ThrowAsJavaScriptException();
+      return;
+    }
+
+    // The blob owns its memory, so it is freed with the last channel using it.
+    ie::Blob::Ptr meanDataBlob = utils::AllocateBlob(tensor);
+    {
+      ie::LockedMemory<void> memory =
+          ie::as<ie::MemoryBlob>(meanDataBlob)->wmap();
+      memcpy(memory.as<void*>(), meanDataBuffer, meanDataLength);
+    }
     this->_actual->meanData = meanDataBlob;
   } catch (const std::exception& error) {
     Napi::TypeError::New(env, error.what()).ThrowAsJavaScriptException();
@@ -5,6 +5,7 @@
 #include <core.h>
 #include <napi.h>
 #include <uv.h>
+#include <vector>
 
 using namespace Napi;
 
@@ -12,6 +13,36 @@ namespace ie = InferenceEngine;
 
 namespace ienodejs {
 
+namespace {
+
+// Splits a planar (CHW) or interleaved (HWC) image into the per-channel mean
+// buffers in a single pass.
+template <typename T>
+void DeinterleaveMeanImage(const T* source,
+                           bool interleaved,
+                           size_t channels,
+                           size_t planeSize,
+                           std::vector<float*>& planes) {
+  if (interleaved) {
+    for (size_t i = 0; i < planeSize; ++i) {
+      const T* pixel = source + i * channels;
+      for (size_t c = 0; c < channels; ++c) {
+        planes[c][i] = static_cast<float>(pixel[c]);
+      }
+    }
+  } else {
+    for (size_t c = 0; c < channels; ++c) {
+      const T* plane = source + c * planeSize;
+      float* destination = planes[c];
+      for (size_t i = 0; i < planeSize; ++i) {
+        destination[i] = static_cast<float>(plane[i]);
+      }
+    }
+  }
+}
+
+}  // namespace
+
 Napi::FunctionReference PreProcessInfo::constructor;
 
 void PreProcessInfo::Init(const Napi::Env& env) {
@@ -33,6 +64,7 @@ void PreProcessInfo::Init(const Napi::Env& env) {
                          &PreProcessInfo::GetNumberOfChannels),
           InstanceMethod("getPreProcessChannel",
                          &PreProcessInfo::GetPreProcessChannel),
+          InstanceMethod("setMeanImage", &PreProcessInfo::SetMeanImage),
       });
 
   constructor = Napi::Persistent(func);
@@ -218,4 +250,144 @@ Napi::Value PreProcessInfo::GetPreProcessChannel(
   return PreProcessChannel::NewInstance(env, pre_info, index);
 }
 
+void PreProcessInfo::SetMeanImage(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1 || info.Length() > 2) {
+    Napi::TypeError::New(env, "Wrong number of arguments")
+        .ThrowAsJavaScriptException();
+    return;
+  }
+
+  if (!info[0].IsObject() || (info.Length() == 2 && !info[1].IsObject())) {
+    Napi::TypeError::New(env, "Wrong type of arguments")
+        .ThrowAsJavaScriptException();
+    return;
+  }
+
+  // The dims of the input are in NCHW order whatever its layout is.
+  ie::SizeVector inputDims = _input_info->getTensorDesc().getDims();
+  if (inputDims.size() != 4) {
+    Napi::TypeError::New(env, "The input should be 4-dimensional")
+        .ThrowAsJavaScriptException();
+    return;
+  }
+  size_t channels = inputDims[1];
+  size_t height = inputDims[2];
+  size_t width = inputDims[3];
+  ie::PreProcessInfo& preProcess = _input_info->getPreProcess();
+  if (preProcess.getNumberOfChannels() != 0 &&
+      preProcess.getNumberOfChannels() != channels) {
+    Napi::TypeError::New(env,
+                         "The number of channels does not match the input")
+        .ThrowAsJavaScriptException();
+    return;
+  }
+
+  Napi::Object source = info[0].ToObject();
+  std::vector<ie::Blob::Ptr> meanBlobs;
+
+  try {
+    if (source.InstanceOf(constructor.Value())) {
+      // Share the mean blobs of another input, without copying them.
+      ie::PreProcessInfo& sourcePreProcess =
+          Napi::ObjectWrap<PreProcessInfo>::Unwrap(source)
+              ->_input_info->getPreProcess();
+      if (sourcePreProcess.getMeanVariant() != ie::MeanVariant::MEAN_IMAGE ||
+          sourcePreProcess.getNumberOfChannels() != channels) {
+        Napi::TypeError::New(env, "The source has no matching mean image")
+            .ThrowAsJavaScriptException();
+        return;
+      }
+      for (size_t c = 0; c < channels; ++c) {
+        if (!sourcePreProcess[c]->meanData) {
+          Napi::TypeError::New(env, "The source has no matching mean image")
+              .ThrowAsJavaScriptException();
+          return;
+        }
+        meanBlobs.push_back(sourcePreProcess[c]->meanData);
+      }
+    } else if (source.IsTypedArray()) {
+      Napi::TypedArray array = source.As<Napi::TypedArray>();
+      napi_typedarray_type type = array.TypedArrayType();
+      if (type != napi_float32_array && type != napi_uint8_array &&
+          type != napi_uint8_clamped_array) {
+        Napi::TypeError::New(env, "The mean image should be fp32 or u8")
+            .ThrowAsJavaScriptException();
+        return;
+      }
+
+      bool interleaved = false;
+      if (info.Length() == 2) {
+        Napi::Object options = info[1].ToObject();
+        if (options.Has("layout")) {
+          std::string layout = options.Get("layout").ToString();
+          if (layout == "nhwc" || layout == "hwc") {
+            interleaved = true;
+          } else if (layout != "nchw" && layout != "chw") {
+            Napi::TypeError::New(env, "Invalid layout " + layout)
+                .ThrowAsJavaScriptException();
+            return;
+          }
+        }
+        if (options.Has("precision")) {
+          std::string precision = options.Get("precision").ToString();
+          if (!utils::IsValidPrecisionName(precision) ||
+              !utils::IsTypedArrayOfPrecision(
+                  type, utils::GetPrecisionByName(precision))) {
+            Napi::TypeError::New(env, "The data does not match precision " +
+                                          precision)
+                .ThrowAsJavaScriptException();
+            return;
+          }
+        }
+      }
+
+      size_t planeSize = height * width;
+      if (array.ElementLength() != channels * planeSize) {
+        Napi::TypeError::New(env, "Dims does not match the data")
+            .ThrowAsJavaScriptException();
+        return;
+      }
+
+      ie::TensorDesc planeDesc(ie::Precision::FP32, {height, width},
+                               ie::Layout::HW);
+      std::vector<ie::LockedMemory<void>> memories;
+      std::vector<float*> planes;
+      memories.reserve(channels);
+      for (size_t c = 0; c < channels; ++c) {
+        meanBlobs.push_back(utils::AllocateBlob(planeDesc));
+        memories.push_back(ie::as<ie::MemoryBlob>(meanBlobs[c])->wmap());
+        planes.push_back(memories[c].as<float*>());
+      }
+
+      void* data = utils::GetTypedArrayData(array);
+      if (type == napi_float32_array) {
+        DeinterleaveMeanImage(static_cast<const float*>(data), interleaved,
+                              channels, planeSize, planes);
+      } else {
+        DeinterleaveMeanImage(static_cast<const uint8_t*>(data), interleaved,
+                              channels, planeSize, planes);
+      }
+    } else {
+      Napi::TypeError::New(env, "Wrong type of arguments")
+          .ThrowAsJavaScriptException();
+      return;
+    }
+
+    if (preProcess.getNumberOfChannels() == 0) {
+      preProcess.init(channels);
+    }
+    for (size_t c = 0; c < channels; ++c) {
+      preProcess[c]->meanData = meanBlobs[c];
+    }
+    preProcess.setVariant(ie::MeanVariant::MEAN_IMAGE);
+  } catch (const std::exception& error) {
+    Napi::TypeError::New(env, error.what()).ThrowAsJavaScriptException();
+  } catch (...) {
+    Napi::Error::New(env, "Unknown/internal exception happened.")
+        .ThrowAsJavaScriptException();
+  }
+}
+
 }  // namespace ienodejs
@@ -0,0 +1,139 @@
+#include "ring_buffer.h"
+#include "utils.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+using namespace Napi;
+
+namespace ie = InferenceEngine;
+
+namespace ienodejs {
+
+Napi::FunctionReference RingBuffer::constructor;
+
+void RingBuffer::Init(const Napi::Env& env) {
+  Napi::HandleScope scope(env);
+
+  Napi::Function func =
+      DefineClass(env, "RingBuffer",
+                  {InstanceMethod("append", &RingBuffer::Append),
+                   InstanceMethod("reset", &RingBuffer::Reset),
+                   InstanceAccessor("ready", &RingBuffer::IsReady, nullptr),
+                   InstanceAccessor("window", &RingBuffer::GetWindow, nullptr),
+                   InstanceAccessor("hop", &RingBuffer::GetHop, nullptr),
+                   InstanceAccessor("pending", &RingBuffer::GetPending,
+                                    nullptr)});
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+}
+
+RingBuffer::RingBuffer(const Napi::CallbackInfo& info)
+    : Napi::ObjectWrap<RingBuffer>(info) {}
+
+Napi::Value RingBuffer::NewInstance(const Napi::Env& env,
+                                    const ie::Precision& precision,
+                                    size_t window,
+                                    size_t hop) {
+  Napi::EscapableHandleScope scope(env);
+
+  Napi::Object obj = constructor.New({});
+  RingBuffer* ring = Napi::ObjectWrap<RingBuffer>::Unwrap(obj);
+  ring->precision_ = precision;
+  ring->element_size_ = precision.size();
+  ring->window_ = window;
+  ring->hop_ = hop;
+  ring->storage_.resize(window * ring->element_size_);
+
+  return scope.Escape(napi_value(obj)).ToObject();
+}
+
+void RingBuffer::CopyWindow(void* data, size_t byte_size) {
+  if (byte_size != storage_.size()) {
+    throw std::invalid_argument("The ring buffer does not match the input");
+  }
+  uint8_t* dst = static_cast<uint8_t*>(data);
+  const size_t es = element_size_;
+  if (total_ < window_) {
+    // The buffer has not wrapped, so the samples start at 0 and end at head_.
+    const size_t missing = window_ - head_;
+    std::memset(dst, 0, missing * es);
+    std::memcpy(dst + missing * es, storage_.data(), head_ * es);
+  } else {
+    std::memcpy(dst, storage_.data() + head_ * es, (window_ - head_) * es);
+    std::memcpy(dst + (window_ - head_) * es, storage_.data(), head_ * es);
+  }
+  pending_ = 0;
+}
+
+bool RingBuffer::Ready() const {
+  return total_ >= window_ && pending_ >= hop_;
+}
+
+Napi::Value RingBuffer::Append(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  if (info.Length() != 1) {
+    Napi::TypeError::New(env, "Wrong number of arguments")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  if (!info[0].IsTypedArray() ||
+      !utils::IsTypedArrayOfPrecision(
+          info[0].As<Napi::TypedArray>().TypedArrayType(), precision_)) {
+    Napi::TypeError::New(env,
+                         "The samples do not match the precision " +
+                             utils::GetNameOfPrecision(precision_))
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  Napi::TypedArray array = info[0].As<Napi::TypedArray>();
+  const uint8_t* src =
+      static_cast<const uint8_t*>(utils::GetTypedArrayData(array));
+  size_t count = array.ElementLength();
+  const size_t es = element_size_;
+  total_ += count;
+  pending_ += count;
+  if (count >= window_) {
+    // Only the newest window of a long chunk is kept.
+    std::memcpy(storage_.data(), src + (count - window_) * es, window_ * es);
+    head_ = 0;
+  } else {
+    const size_t first = std::min(count, window_ - head_);
+    std::memcpy(storage_.data() + head_ * es, src, first * es);
+    std::memcpy(storage_.data(), src + first * es, (count - first) * es);
+    head_ = (head_ + count) % window_;
+  }
+  return Napi::Boolean::New(env, Ready());
+}
+
+void RingBuffer::Reset(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  if (info.Length() > 0) {
+    Napi::TypeError::New(env, "Invalid argument").ThrowAsJavaScriptException();
+    return;
+  }
+  head_ = 0;
+  total_ = 0;
+  pending_ = 0;
+}
+
+Napi::Value RingBuffer::IsReady(const Napi::CallbackInfo& info) {
+  return Napi::Boolean::New(info.Env(), Ready());
+}
+
+Napi::Value RingBuffer::GetWindow(const Napi::CallbackInfo& info) {
+  return Napi::Number::New(info.Env(), static_cast<double>(window_));
+}
+
+Napi::Value RingBuffer::GetHop(const Napi::CallbackInfo& info) {
+  return Napi::Number::New(info.Env(), static_cast<double>(hop_));
+}
+
+Napi::Value RingBuffer::GetPending(const Napi::CallbackInfo& info) {
+  return Napi::Number::New(info.Env(), static_cast<double>(pending_));
+}
+
+}  // namespace ienodejs
@@ -0,0 +1,141 @@
+#include "segmentation_utils.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace ienodejs {
+
+namespace segmentation {
+
+namespace {
+
+// The source positions of the pixel centers of a scaled axis.
+struct Taps {
+  std::vector<size_t> first;
+  std::vector<size_t> second;
+  std::vector<float> weight;
+};
+
+void ComputeTaps(size_t src_size, size_t dst_size, Taps* taps) {
+  taps->first.resize(dst_size);
+  taps->second.resize(dst_size);
+  taps->weight.resize(dst_size);
+  const float ratio = static_cast<float>(src_size) / dst_size;
+  for (size_t i = 0; i < dst_size; ++i) {
+    float position = std::max((i + 0.5f) * ratio - 0.5f, 0.0f);
+    size_t first = std::min(static_cast<size_t>(position), src_size - 1);
+    taps->first[i] = first;
+    taps->second[i] = std::min(first + 1, src_size - 1);
+    taps->weight[i] = std::min(position - first, 1.0f);
+  }
+}
+
+}  // namespace
+
+void ArgMax(const float* scores,
+            size_t channels,
+            size_t width,
+            size_t height,
+            uint8_t* mask) {
+  // Blocks of pixels go through the planes one by one, so that the inner
+  // loop reads contiguous scores into local arrays that nothing aliases and
+  // the compiler can vectorize it.
+  const size_t kBlock = 512;
+  const size_t area = width * height;
+  if (channels == 1) {
+    for (size_t i = 0; i < area; ++i) {
+      mask[i] = static_cast<uint8_t>(
+          std::min(std::max(scores[i], 0.0f), 255.0f));
+    }
+    return;
+  }
+  float best[kBlock];
+  int32_t labels[kBlock];
+  for (size_t start = 0; start < area; start += kBlock) {
+    const size_t size = std::min(kBlock, area - start);
+    std::copy(scores + start, scores + start + size, best);
+    std::fill(labels, labels + size, 0);
+    for (size_t c = 1; c < channels; ++c) {
+      const float* plane = scores + c * area + start;
+      const int32_t label = static_cast<int32_t>(c);
+      for (size_t i = 0; i < size; ++i) {
+        const float score = plane[i];
+        const int32_t higher = -static_cast<int32_t>(score > best[i]);
+        best[i] = score > best[i] ? score : best[i];
+        labels[i] = (labels[i] & ~higher) | (label & higher);
+      }
+    }
+    std::copy(labels, labels + size, mask + start);
+  }
+}
+
+void ResizeNearest(const uint8_t* mask,
+                   size_t width,
+                   size_t height,
+                   uint8_t* output,
+                   size_t output_width,
+                   size_t output_height) {
+  std::vector<size_t> xs(output_width);
+  for (size_t x = 0; x < output_width; ++x) {
+    xs[x] = std::min(x * width / output_width, width - 1);
+  }
+  for (size_t y = 0; y < output_height; ++y) {
+    const uint8_t* row =
+        mask + std::min(y * height / output_height, height - 1) * width;
+    uint8_t* out = output + y * output_width;
+    for (size_t x = 0; x < output_width; ++x) {
+      out[x] = row[xs[x]];
+    }
+  }
+}
+
+void ArgMaxBilinear(const float* scores,
+                    size_t channels,
+                    size_t width,
+                    size_t height,
+                    uint8_t* output,
+                    size_t output_width,
+                    size_t output_height) {
+  Taps xs;
+  Taps ys;
+  ComputeTaps(width, output_width, &xs);
+  ComputeTaps(height, output_height, &ys);
+  const size_t area = width * height;
+  // One output row at a time: each class is interpolated into |row| and
+  // compared with the best so far.
+  std::vector<float> best(output_width);
+  std::vector<float> row(output_width);
+  std::vector<int32_t> labels(output_width);
+  for (size_t y = 0; y < output_height; ++y) {
+    std::fill(labels.begin(), labels.end(), 0);
+    const float wy = ys.weight[y];
+    for (size_t c = 0; c < channels; ++c) {
+      const float* top = scores + c * area + ys.first[y] * width;
+      const float* bottom = scores + c * area + ys.second[y] * width;
+      for (size_t x = 0; x < output_width; ++x) {
+        const float wx = xs.weight[x];
+        const float upper =
+            top[xs.first[x]] + (top[xs.second[x]] - top[xs.first[x]]) * wx;
+        const float lower = bottom[xs.first[x]] +
+                            (bottom[xs.second[x]] - bottom[xs.first[x]]) * wx;
+        row[x] = upper + (lower - upper) * wy;
+      }
+      if (c == 0) {
+        best.swap(row);
+        continue;
+      }
+      const int32_t label = static_cast<int32_t>(c);
+      for (size_t x = 0; x < output_width; ++x) {
+        const float score = row[x];
+        const int32_t higher = -static_cast<int32_t>(score > best[x]);
+        best[x] = score > best[x] ? score : best[x];
+        labels[x] = (labels[x] & ~higher) | (label & higher);
+      }
+    }
+    std::copy(labels.begin(), labels.end(), output + y * output_width);
+  }
+}
+
+}  // namespace segmentation
+
+}  // namespace ienodejs
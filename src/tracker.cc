@@ -0,0 +1,181 @@
+#include "tracker.h"
+#include "utils.h"
+
+#include <algorithm>
+#include <string>
+
+using namespace Napi;
+
+namespace ienodejs {
+
+Napi::FunctionReference Tracker::constructor;
+
+void Tracker::Init(const Napi::Env& env, Napi::Object exports) {
+  Napi::HandleScope scope(env);
+
+  Napi::Function func = DefineClass(
+      env, "Tracker",
+      {InstanceMethod("update", &Tracker::Update),
+       InstanceMethod("predict", &Tracker::Predict),
+       InstanceMethod("reset", &Tracker::Reset),
+       InstanceAccessor("needsDetection", &Tracker::NeedsDetection, nullptr),
+       InstanceAccessor("detectionInterval", &Tracker::GetDetectionInterval,
+                        &Tracker::SetDetectionInterval)});
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+  exports.Set("Tracker", func);
+}
+
+Tracker::Tracker(const Napi::CallbackInfo& info)
+    : Napi::ObjectWrap<Tracker>(info) {
+  Napi::Env env = info.Env();
+  if (info.Length() > 1 || (info.Length() == 1 && !info[0].IsObject())) {
+    Napi::TypeError::New(env, "Wrong type of arguments")
+        .ThrowAsJavaScriptException();
+    return;
+  }
+  if (info.Length() == 0) {
+    return;
+  }
+
+  Napi::Object options = info[0].ToObject();
+  const char* keys[] = {"iouThreshold", "maxAge", "minHits", "threshold"};
+  for (const char* key : keys) {
+    if (options.Has(key) && !options.Get(key).IsNumber()) {
+      Napi::TypeError::New(env, std::string(key) + " should be a number")
+          .ThrowAsJavaScriptException();
+      return;
+    }
+  }
+  if (options.Has("iouThreshold")) {
+    options_.iou_threshold =
+        options.Get("iouThreshold").ToNumber().FloatValue();
+  }
+  if (options.Has("maxAge")) {
+    options_.max_age = options.Get("maxAge").ToNumber().Uint32Value();
+  }
+  if (options.Has("minHits")) {
+    options_.min_hits = options.Get("minHits").ToNumber().Uint32Value();
+  }
+  if (options.Has("threshold")) {
+    threshold_ = options.Get("threshold").ToNumber().FloatValue();
+  }
+  if (options.Has("classAgnostic")) {
+    options_.class_agnostic = options.Get("classAgnostic").ToBoolean();
+  }
+  if (options.Has("detectionInterval")) {
+    SetDetectionInterval(info, options.Get("detectionInterval"));
+  }
+}
+
+Napi::Value Tracker::Update(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  if (info.Length() != 1) {
+    Napi::TypeError::New(env, "Wrong number of arguments")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  if (!info[0].IsTypedArray() ||
+      info[0].As<Napi::TypedArray>().TypedArrayType() != napi_float32_array) {
+    Napi::TypeError::New(env, "Wrong type of arguments")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  Napi::Float32Array array = info[0].As<Napi::Float32Array>();
+  const float* rows =
+      static_cast<const float*>(utils::GetTypedArrayData(array));
+  if (array.ElementLength() % detection::kDetectionSize != 0) {
+    Napi::RangeError::New(env, "The detections are not rows of 7 values")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  std::vector<detection::Detection> detections;
+  for (size_t i = 0; i < array.ElementLength();
+       i += detection::kDetectionSize) {
+    const float* row = rows + i;
+    // DetectionOutput ends the valid rows with a negative image id.
+    if (row[0] < 0) {
+      break;
+    }
+    if (row[2] >= threshold_) {
+      detections.push_back(
+          {row[0], row[1], row[2], row[3], row[4], row[5], row[6]});
+    }
+  }
+
+  tracking::PredictTracks(&tracks_);
+  tracking::UpdateTracks(detections, options_, &tracks_, &next_id_);
+  frames_until_detection_ = detection_interval_ - 1;
+  return CreateTrackArray(env);
+}
+
+Napi::Value Tracker::Predict(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  if (info.Length() > 0) {
+    Napi::TypeError::New(env, "Invalid argument").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  tracking::PredictTracks(&tracks_);
+  if (frames_until_detection_ > 0) {
+    --frames_until_detection_;
+  }
+  return CreateTrackArray(env);
+}
+
+void Tracker::Reset(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  if (info.Length() > 0) {
+    Napi::TypeError::New(env, "Invalid argument").ThrowAsJavaScriptException();
+    return;
+  }
+  // The ids keep increasing, so an old id never names a new object.
+  tracks_.clear();
+  frames_until_detection_ = 0;
+}
+
+Napi::Value Tracker::NeedsDetection(const Napi::CallbackInfo& info) {
+  return Napi::Boolean::New(info.Env(), frames_until_detection_ == 0);
+}
+
+Napi::Value Tracker::GetDetectionInterval(const Napi::CallbackInfo& info) {
+  return Napi::Number::New(info.Env(), detection_interval_);
+}
+
+void Tracker::SetDetectionInterval(const Napi::CallbackInfo& info,
+                                   const Napi::Value& value) {
+  if (!value.IsNumber() || value.ToNumber().Uint32Value() == 0) {
+    Napi::TypeError::New(info.Env(),
+                         "detectionInterval should be a positive number")
+        .ThrowAsJavaScriptException();
+    return;
+  }
+  detection_interval_ = value.ToNumber().Uint32Value();
+  frames_until_detection_ =
+      std::min(frames_until_detection_, detection_interval_ - 1);
+}
+
+Napi::Float32Array Tracker::CreateTrackArray(const Napi::Env& env) const {
+  std::vector<detection::Detection> boxes;
+  for (const tracking::Track& track : tracks_) {
+    if (track.misses > 0 || track.hits < options_.min_hits) {
+      continue;
+    }
+    detection::Detection box = {static_cast<float>(track.id), track.label,
+                                track.confidence};
+    track.filter.GetBox(&box);
+    boxes.push_back(box);
+  }
+  Napi::Float32Array array =
+      Napi::Float32Array::New(env, boxes.size() * detection::kDetectionSize);
+  float* data = array.Data();
+  for (const detection::Detection& box : boxes) {
+    const float row[] = {box.image_id, box.label, box.confidence, box.x1,
+                         box.y1,       box.x2,    box.y2};
+    data = std::copy(row, row + detection::kDetectionSize, data);
+  }
+  return array;
+}
+
+}  // namespace ienodejs
@@ -0,0 +1,166 @@
+#include "tracking_utils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+
+namespace ienodejs {
+
+namespace tracking {
+
+namespace {
+
+// The noise of SORT: measurements of the area and ratio are less reliable
+// than those of the center, and so are changes of the area.
+const float kPositionNoise = 1.0f;
+const float kVelocityNoise = 0.01f;
+const float kAreaVelocityNoise = 0.0001f;
+const float kCenterMeasurementNoise = 1.0f;
+const float kSizeMeasurementNoise = 10.0f;
+const float kInitialVariance = 10.0f;
+const float kInitialVelocityVariance = 10000.0f;
+
+}  // namespace
+
+BoxFilter::BoxFilter(const detection::Detection& box) {
+  const float width = box.x2 - box.x1;
+  const float height = box.y2 - box.y1;
+  auto init = [](float value) {
+    return Axis{value, 0.0f, kInitialVariance, 0.0f, kInitialVelocityVariance};
+  };
+  x_ = init(box.x1 + width / 2.0f);
+  y_ = init(box.y1 + height / 2.0f);
+  area_ = init(width * height);
+  ratio_ = height > 0.0f ? width / height : 1.0f;
+  ratio_variance_ = kInitialVariance;
+}
+
+void BoxFilter::Predict() {
+  // The area never shrinks below zero.
+  if (area_.value + area_.velocity <= 0.0f) {
+    area_.velocity = 0.0f;
+  }
+  Predict(&x_, kPositionNoise, kVelocityNoise);
+  Predict(&y_, kPositionNoise, kVelocityNoise);
+  Predict(&area_, kPositionNoise, kAreaVelocityNoise);
+  ratio_variance_ += kPositionNoise;
+}
+
+void BoxFilter::Update(const detection::Detection& box) {
+  const float width = box.x2 - box.x1;
+  const float height = box.y2 - box.y1;
+  Update(&x_, box.x1 + width / 2.0f, kCenterMeasurementNoise);
+  Update(&y_, box.y1 + height / 2.0f, kCenterMeasurementNoise);
+  Update(&area_, width * height, kSizeMeasurementNoise);
+  if (height > 0.0f) {
+    const float gain =
+        ratio_variance_ / (ratio_variance_ + kSizeMeasurementNoise);
+    ratio_ += gain * (width / height - ratio_);
+    ratio_variance_ *= 1.0f - gain;
+  }
+}
+
+void BoxFilter::GetBox(detection::Detection* box) const {
+  const float area = std::max(area_.value, 0.0f);
+  const float width = std::sqrt(area * ratio_);
+  const float height = width > 0.0f ? area / width : 0.0f;
+  box->x1 = x_.value - width / 2.0f;
+  box->y1 = y_.value - height / 2.0f;
+  box->x2 = x_.value + width / 2.0f;
+  box->y2 = y_.value + height / 2.0f;
+}
+
+void BoxFilter::Predict(Axis* axis, float q_value, float q_velocity) {
+  // x' = F x, P' = F P F^T + Q with F = [[1, 1], [0, 1]].
+  axis->value += axis->velocity;
+  axis->p00 += 2.0f * axis->p01 + axis->p11 + q_value;
+  axis->p01 += axis->p11;
+  axis->p11 += q_velocity;
+}
+
+void BoxFilter::Update(Axis* axis, float measurement, float r) {
+  // Only the value is measured, H = [1, 0].
+  const float s = axis->p00 + r;
+  const float k0 = axis->p00 / s;
+  const float k1 = axis->p01 / s;
+  const float residual = measurement - axis->value;
+  axis->value += k0 * residual;
+  axis->velocity += k1 * residual;
+  const float p00 = axis->p00;
+  const float p01 = axis->p01;
+  axis->p00 = (1.0f - k0) * p00;
+  axis->p01 = (1.0f - k0) * p01;
+  axis->p11 -= k1 * p01;
+}
+
+void PredictTracks(std::vector<Track>* tracks) {
+  for (Track& track : *tracks) {
+    track.filter.Predict();
+  }
+}
+
+void UpdateTracks(const std::vector<detection::Detection>& detections,
+                  const TrackerOptions& options,
+                  std::vector<Track>* tracks,
+                  uint32_t* next_id) {
+  // Every pair that overlaps enough, best first.
+  std::vector<std::tuple<float, size_t, size_t>> pairs;
+  for (size_t t = 0; t < tracks->size(); ++t) {
+    const Track& track = (*tracks)[t];
+    detection::Detection predicted = {};
+    track.filter.GetBox(&predicted);
+    for (size_t d = 0; d < detections.size(); ++d) {
+      if (!options.class_agnostic && detections[d].label != track.label) {
+        continue;
+      }
+      const float iou = detection::GetOverlap(predicted, detections[d],
+                                              detection::OverlapMetric::IOU);
+      if (iou >= options.iou_threshold) {
+        pairs.emplace_back(iou, t, d);
+      }
+    }
+  }
+  std::stable_sort(pairs.begin(), pairs.end(),
+                   [](const std::tuple<float, size_t, size_t>& a,
+                      const std::tuple<float, size_t, size_t>& b) {
+                     return std::get<0>(a) > std::get<0>(b);
+                   });
+
+  std::vector<bool> matched_tracks(tracks->size());
+  std::vector<bool> matched_detections(detections.size());
+  for (const auto& pair : pairs) {
+    const size_t t = std::get<1>(pair);
+    const size_t d = std::get<2>(pair);
+    if (matched_tracks[t] || matched_detections[d]) {
+      continue;
+    }
+    matched_tracks[t] = true;
+    matched_detections[d] = true;
+    Track& track = (*tracks)[t];
+    track.filter.Update(detections[d]);
+    track.label = detections[d].label;
+    track.confidence = detections[d].confidence;
+    ++track.hits;
+    track.misses = 0;
+  }
+
+  std::vector<Track> kept;
+  for (size_t t = 0; t < tracks->size(); ++t) {
+    Track& track = (*tracks)[t];
+    if (!matched_tracks[t] && ++track.misses > options.max_age) {
+      continue;
+    }
+    kept.push_back(track);
+  }
+  for (size_t d = 0; d < detections.size(); ++d) {
+    if (!matched_detections[d]) {
+      kept.push_back({(*next_id)++, BoxFilter(detections[d]),
+                      detections[d].label, detections[d].confidence, 1, 0});
+    }
+  }
+  tracks->swap(kept);
+}
+
+}  // namespace tracking
+
+}  // namespace ienodejs
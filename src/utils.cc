@@ -1,5 +1,8 @@
 #include "utils.h"
 
+#include <stdexcept>
+#include <string>
+
 namespace ie = InferenceEngine;
 
 namespace ienodejs {
@@ -109,6 +112,19 @@ bool checkTensorDesc(const Napi::Object& tensorDesc) {
   }
 }
 
+ie::TensorDesc GetTensorDescFromObject(const Napi::Object& tensorDesc) {
+  std::string precision = tensorDesc.Get("precision").ToString();
+  std::string layout = tensorDesc.Get("layout").ToString();
+  Napi::Array dims = tensorDesc.Get("dims").As<Napi::Array>();
+  ie::SizeVector dims_vector;
+  for (uint32_t i = 0; i < dims.Length(); ++i) {
+    Napi::Value dim = dims[i];
+    dims_vector.push_back(dim.ToNumber().Uint32Value());
+  }
+  return ie::TensorDesc(GetPrecisionByName(precision), dims_vector,
+                        GetLayoutByName(layout));
+}
+
 bool IsValidLayoutName(const std::string& name) {
   return !(layout_type_map.find(name) == layout_type_map.end());
 }
@@ -174,5 +190,199 @@ std::string GetNameOfMeanVariant(
   return meanvariant_name_map[meanvariant];
 }
 
+ie::Blob::Ptr AllocateBlob(const ie::TensorDesc& desc) {
+  ie::Blob::Ptr blob;
+  switch (desc.getPrecision()) {
+    case ie::Precision::FP32:
+      blob = ie::make_shared_blob<float>(desc);
+      break;
+    case ie::Precision::FP16:
+    case ie::Precision::I16:
+    case ie::Precision::Q78:
+      blob = ie::make_shared_blob<int16_t>(desc);
+      break;
+    case ie::Precision::U16:
+      blob = ie::make_shared_blob<uint16_t>(desc);
+      break;
+    case ie::Precision::U8:
+      blob = ie::make_shared_blob<uint8_t>(desc);
+      break;
+    case ie::Precision::I8:
+      blob = ie::make_shared_blob<int8_t>(desc);
+      break;
+    case ie::Precision::I32:
+      blob = ie::make_shared_blob<int32_t>(desc);
+      break;
+    case ie::Precision::I64:
+      blob = ie::make_shared_blob<int64_t>(desc);
+      break;
+    default:
+      throw std::invalid_argument("Unsupported precision " +
+                                  GetNameOfPrecision(desc.getPrecision()));
+  }
+  blob->allocate();
+  return blob;
+}
+
+ie::Blob::Ptr WrapBlob(const ie::TensorDesc& desc, void* data) {
+  size_t size = GetByteSizeOfTensorDesc(desc) / desc.getPrecision().size();
+  switch (desc.getPrecision()) {
+    case ie::Precision::FP32:
+      return ie::make_shared_blob<float>(desc, static_cast<float*>(data), size);
+    case ie::Precision::FP16:
+    case ie::Precision::I16:
+    case ie::Precision::Q78:
+      return ie::make_shared_blob<int16_t>(desc, static_cast<int16_t*>(data),
+                                           size);
+    case ie::Precision::U16:
+      return ie::make_shared_blob<uint16_t>(desc, static_cast<uint16_t*>(data),
+                                            size);
+    case ie::Precision::U8:
+      return ie::make_shared_blob<uint8_t>(desc, static_cast<uint8_t*>(data),
+                                           size);
+    case ie::Precision::I8:
+      return ie::make_shared_blob<int8_t>(desc, static_cast<int8_t*>(data),
+                                          size);
+    case ie::Precision::I32:
+      return ie::make_shared_blob<int32_t>(desc, static_cast<int32_t*>(data),
+                                           size);
+    case ie::Precision::I64:
+      return ie::make_shared_blob<int64_t>(desc, static_cast<int64_t*>(data),
+                                           size);
+    default:
+      throw std::invalid_argument("Unsupported precision " +
+                                  GetNameOfPrecision(desc.getPrecision()));
+  }
+}
+
+bool IsTypedArrayOfPrecision(const napi_typedarray_type& type,
+                             const ie::Precision& precision) {
+  switch (precision) {
+    case ie::Precision::FP32:
+      return type == napi_float32_array;
+    case ie::Precision::FP16:
+    case ie::Precision::U16:
+      return type == napi_uint16_array;
+    case ie::Precision::I16:
+    case ie::Precision::Q78:
+      return type == napi_int16_array;
+    case ie::Precision::U8:
+      return type == napi_uint8_array || type == napi_uint8_clamped_array;
+    case ie::Precision::I8:
+      return type == napi_int8_array;
+    case ie::Precision::I32:
+      return type == napi_int32_array;
+    default:
+      return false;
+  }
+}
+
+void* GetTypedArrayData(const Napi::TypedArray& array) {
+  // napi_get_arraybuffer_info() rejects SharedArrayBuffers, so ask for the
+  // data pointer of the view directly.
+  void* data = nullptr;
+  napi_status status = napi_get_typedarray_info(
+      array.Env(), array, nullptr, nullptr, &data, nullptr, nullptr);
+  NAPI_THROW_IF_FAILED(array.Env(), status, nullptr);
+  return data;
+}
+
+bool GetBytes(const Napi::Value& value,
+              const uint8_t** data,
+              size_t* byte_length) {
+  if (value.IsArrayBuffer()) {
+    Napi::ArrayBuffer buffer = value.As<Napi::ArrayBuffer>();
+    *data = static_cast<const uint8_t*>(buffer.Data());
+    *byte_length = buffer.ByteLength();
+    return true;
+  }
+  if (value.IsTypedArray()) {
+    Napi::TypedArray array = value.As<Napi::TypedArray>();
+    if (array.TypedArrayType() == napi_uint8_array ||
+        array.TypedArrayType() == napi_uint8_clamped_array) {
+      *data = static_cast<const uint8_t*>(GetTypedArrayData(array));
+      *byte_length = array.ByteLength();
+      return true;
+    }
+  }
+  return false;
+}
+
+Napi::TypedArray CreateTypedArray(const Napi::Env& env,
+                                  const ie::Precision& precision,
+                                  size_t length) {
+  switch (precision) {
+    case ie::Precision::FP32:
+      return Napi::Float32Array::New(env, length);
+    case ie::Precision::FP16:
+    case ie::Precision::U16:
+      return Napi::Uint16Array::New(env, length);
+    case ie::Precision::I16:
+    case ie::Precision::Q78:
+      return Napi::Int16Array::New(env, length);
+    case ie::Precision::U8:
+      return Napi::Uint8Array::New(env, length);
+    case ie::Precision::I8:
+      return Napi::Int8Array::New(env, length);
+    case ie::Precision::I32:
+      return Napi::Int32Array::New(env, length);
+    default:
+      throw std::invalid_argument("Unsupported precision " +
+                                  GetNameOfPrecision(precision));
+  }
+}
+
+size_t GetByteSizeOfTensorDesc(const ie::TensorDesc& desc) {
+  size_t byte_size = desc.getPrecision().size();
+  for (auto dim : desc.getDims()) {
+    byte_size *= dim;
+  }
+  return byte_size;
+}
+
+std::string GetImageTensor(const ie::TensorDesc& desc,
+                           image::Tensor* tensor) {
+  const ie::Precision& precision = desc.getPrecision();
+  if (precision == ie::Precision::U8) {
+    tensor->type = image::ElementType::U8;
+  } else if (precision == ie::Precision::FP16) {
+    tensor->type = image::ElementType::FP16;
+  } else if (precision == ie::Precision::FP32) {
+    tensor->type = image::ElementType::FP32;
+  } else {
+    return "Only U8, FP16 and FP32 Blobs can be filled";
+  }
+  const ie::SizeVector& dims = desc.getDims();
+  if (dims.size() != 4 || dims[1] != 3) {
+    return "The Blob is not a 3-channel image";
+  }
+  tensor->data = nullptr;
+  tensor->width = dims[3];
+  tensor->height = dims[2];
+  tensor->planar = desc.getLayout() != ie::Layout::NHWC;
+  tensor->bgr = true;
+  for (size_t k = 0; k < 3; ++k) {
+    tensor->mean[k] = 0.0f;
+    tensor->std[k] = 1.0f;
+  }
+  tensor->target = {0, 0, tensor->width, tensor->height};
+  tensor->pad = 0.0f;
+  return std::string();
+}
+
+Napi::Object CreateTensorDescObject(const Napi::Env& env,
+                                    const ie::TensorDesc& desc) {
+  Napi::Object js_desc = Napi::Object::New(env);
+  js_desc.Set("precision", GetNameOfPrecision(desc.getPrecision()));
+  js_desc.Set("layout", GetNameOfLayout(desc.getLayout()));
+  ie::SizeVector dims = desc.getDims();
+  Napi::Array js_dims = Napi::Array::New(env, dims.size());
+  for (size_t i = 0; i < dims.size(); ++i) {
+    js_dims[i] = dims[i];
+  }
+  js_desc.Set("dims", js_dims);
+  return js_desc;
+}
+
 }  // namespace utils
-}  // namespace ienodejs
\ No newline at end of file
+}  // namespace ienodejs
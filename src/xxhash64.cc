@@ -0,0 +1,127 @@
+#include "xxhash64.h"
+
+#include <cstring>
+
+namespace ienodejs {
+
+namespace utils {
+
+namespace {
+
+const uint64_t kPrime1 = 11400714785074694791ULL;
+const uint64_t kPrime2 = 14029467366897019727ULL;
+const uint64_t kPrime3 = 1609587929392839161ULL;
+const uint64_t kPrime4 = 9650029242287828579ULL;
+const uint64_t kPrime5 = 2870177450012600261ULL;
+
+inline uint64_t RotateLeft(uint64_t value, int bits) {
+  return (value << bits) | (value >> (64 - bits));
+}
+
+// The hash is defined on little-endian reads.
+inline uint64_t Read64(const uint8_t* data) {
+  uint64_t value;
+  std::memcpy(&value, data, sizeof(value));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  value = __builtin_bswap64(value);
+#endif
+  return value;
+}
+
+inline uint32_t Read32(const uint8_t* data) {
+  uint32_t value;
+  std::memcpy(&value, data, sizeof(value));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  value = __builtin_bswap32(value);
+#endif
+  return value;
+}
+
+inline uint64_t Round(uint64_t accumulator, uint64_t input) {
+  accumulator += input * kPrime2;
+  return RotateLeft(accumulator, 31) * kPrime1;
+}
+
+inline uint64_t MergeRound(uint64_t accumulator, uint64_t value) {
+  accumulator ^= Round(0, value);
+  return accumulator * kPrime1 + kPrime4;
+}
+
+}  // namespace
+
+XXHash64::XXHash64(uint64_t seed) : seed_(seed) {
+  state_[0] = seed + kPrime1 + kPrime2;
+  state_[1] = seed + kPrime2;
+  state_[2] = seed;
+  state_[3] = seed - kPrime1;
+}
+
+void XXHash64::Update(const void* data, size_t size) {
+  const uint8_t* input = static_cast<const uint8_t*>(data);
+  total_size_ += size;
+
+  if (buffer_size_ + size < 32) {
+    std::memcpy(buffer_ + buffer_size_, input, size);
+    buffer_size_ += size;
+    return;
+  }
+  if (buffer_size_ > 0) {
+    const size_t fill = 32 - buffer_size_;
+    std::memcpy(buffer_ + buffer_size_, input, fill);
+    for (int i = 0; i < 4; ++i) {
+      state_[i] = Round(state_[i], Read64(buffer_ + i * 8));
+    }
+    input += fill;
+    size -= fill;
+    buffer_size_ = 0;
+  }
+  for (; size >= 32; input += 32, size -= 32) {
+    for (int i = 0; i < 4; ++i) {
+      state_[i] = Round(state_[i], Read64(input + i * 8));
+    }
+  }
+  std::memcpy(buffer_, input, size);
+  buffer_size_ = size;
+}
+
+uint64_t XXHash64::Digest() const {
+  uint64_t hash;
+  if (total_size_ >= 32) {
+    hash = RotateLeft(state_[0], 1) + RotateLeft(state_[1], 7) +
+           RotateLeft(state_[2], 12) + RotateLeft(state_[3], 18);
+    for (int i = 0; i < 4; ++i) {
+      hash = MergeRound(hash, state_[i]);
+    }
+  } else {
+    hash = seed_ + kPrime5;
+  }
+  hash += total_size_;
+
+  const uint8_t* tail = buffer_;
+  size_t size = buffer_size_;
+  for (; size >= 8; tail += 8, size -= 8) {
+    hash ^= Round(0, Read64(tail));
+    hash = RotateLeft(hash, 27) * kPrime1 + kPrime4;
+  }
+  if (size >= 4) {
+    hash ^= Read32(tail) * kPrime1;
+    hash = RotateLeft(hash, 23) * kPrime2 + kPrime3;
+    tail += 4;
+    size -= 4;
+  }
+  for (; size > 0; ++tail, --size) {
+    hash ^= *tail * kPrime5;
+    hash = RotateLeft(hash, 11) * kPrime1;
+  }
+
+  hash ^= hash >> 33;
+  hash *= kPrime2;
+  hash ^= hash >> 29;
+  hash *= kPrime3;
+  hash ^= hash >> 32;
+  return hash;
+}
+
+}  // namespace utils
+
+}  // namespace ienodejs
@@ -0,0 +1,78 @@
+const describe = require('mocha').describe;
+var chai = require('chai');
+var expect = chai.expect;
+
+const ie = require('../lib/inference-engine-node');
+
+async function loadNetwork(core, name) {
+  const net = await core.readNetwork(
+      `./models/${name}/FP16/${name}.xml`, `./models/${name}/FP16/${name}.bin`);
+  return core.loadNetwork(net, 'CPU');
+}
+
+// A gray frame with a bright square in the middle.
+function createFrame(width, height) {
+  const pixels = new Uint8Array(width * height * 4).fill(128);
+  for (let y = height / 4; y < height * 3 / 4; ++y) {
+    const row = y * width * 4;
+    pixels.fill(255, row + width, row + width * 3);
+  }
+  return pixels;
+}
+
+describe('Cascade Test', function() {
+  it('Cascade should classify the crop of each detection', async () => {
+    const core = new ie.Core();
+    const detector = await loadNetwork(core, 'mobilenetssd');
+    const classifier = await loadNetwork(core, 'squeezenet1.1');
+    const cascade = new ie.Cascade(
+        detector, classifier, {threshold: 0, maxDetections: 3, topK: 2});
+    const result = await cascade.run(createFrame(320, 240), 320, 240);
+    expect(result.detections).to.be.an.instanceof(Float32Array);
+    expect(result.classes).to.be.an.instanceof(Int32Array);
+    const boxes = result.detections.length / 7;
+    expect(boxes).to.be.within(1, 3);
+    expect(result.classes.length).to.equal(boxes * 2);
+    expect(result.scores.length).to.equal(boxes * 2);
+    for (let i = 0; i < boxes; ++i) {
+      expect(result.scores[i * 2]).to.be.at.least(result.scores[i * 2 + 1]);
+      expect(result.classes[i * 2]).to.be.within(0, 999);
+    }
+
+    // Concurrent runs use their own requests.
+    const frame = createFrame(64, 48);
+    const results = await Promise.all(
+        [cascade.run(frame, 64, 48), cascade.run(frame, 64, 48)]);
+    expect(Array.from(results[0].classes))
+        .to.eql(Array.from(results[1].classes));
+  });
+
+  it('Cascade should skip the labels not asked for', async () => {
+    const core = new ie.Core();
+    const detector = await loadNetwork(core, 'mobilenetssd');
+    const classifier = await loadNetwork(core, 'squeezenet1.1');
+    const cascade =
+        new ie.Cascade(detector, classifier, {threshold: 0, labels: [-1]});
+    const result = await cascade.run(createFrame(64, 48), 64, 48);
+    expect(result.detections.length).to.equal(0);
+    expect(result.classes.length).to.equal(0);
+  });
+
+  it('Cascade should throw for invalid arguments', async () => {
+    const core = new ie.Core();
+    const detector = await loadNetwork(core, 'mobilenetssd');
+    const classifier = await loadNetwork(core, 'squeezenet1.1');
+    expect(() => new ie.Cascade(detector)).to.throw(TypeError);
+    expect(() => new ie.Cascade(detector, {})).to.throw(TypeError);
+    expect(() => new ie.Cascade(detector, classifier, {topK: 0}))
+        .to.throw(TypeError);
+    expect(() => new ie.Cascade(detector, classifier, {detectorInput: 'x'}))
+        .to.throw(TypeError);
+    const cascade = new ie.Cascade(detector, classifier);
+    let error;
+    await cascade.run(new Uint8Array(16), 4, 2).catch((e) => error = e);
+    expect(error).to.be.an.instanceof(RangeError);
+    await cascade.run([0, 0, 0, 0], 1, 1).catch((e) => error = e);
+    expect(error).to.be.an.instanceof(TypeError);
+  });
+});
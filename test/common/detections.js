@@ -0,0 +1,8 @@
+// Packs [label, confidence, x1, y1, x2, y2] boxes as DetectionOutput rows.
+function detections(boxes, imageId = 0) {
+  const rows = new Float32Array(boxes.length * 7);
+  boxes.forEach((box, i) => rows.set([imageId, ...box], i * 7));
+  return rows;
+}
+
+module.exports = {detections};
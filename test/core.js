@@ -167,4 +167,18 @@ describe('Core Test', function() {
     const net = await core.readNetwork(model_path, weights_path);
     expect(core.loadNetwork(net, 'foo')).to.be.rejectedWith(Error);
   });
-});
\ No newline at end of file
+
+  it('loadNetwork should reject for a disposed network', async () => {
+    const net = await core.readNetwork(model_path, weights_path);
+    net.dispose();
+    expect(() => net.getName()).to.throw(Error);
+    await expect(core.loadNetwork(net, 'CPU')).to.be.rejectedWith(Error);
+  });
+
+  it('ExecutableNetwork.dispose should make later calls throw', async () => {
+    const net = await core.readNetwork(model_path, weights_path);
+    const exec_net = await core.loadNetwork(net, 'CPU');
+    exec_net.dispose();
+    expect(() => exec_net.createInferRequest()).to.throw(Error);
+  });
+});
@@ -0,0 +1,114 @@
+const describe = require('mocha').describe;
+var chai = require('chai');
+var chaiAsPromised = require('chai-as-promised');
+chai.use(chaiAsPromised);
+var expect = chai.expect;
+
+const ie = require('../lib/inference-engine-node');
+
+describe('EmbeddingIndex Test', function() {
+  it('EmbeddingIndex should find the most similar embeddings', async () => {
+    const index = new ie.EmbeddingIndex(3);
+    index.add([10, 20, 30], new Float32Array([1, 0, 0, 0, 2, 0, 1, 1, 0]));
+    expect(index.size).to.equal(3);
+    expect(index.dimension).to.equal(3);
+    const result = await index.search(new Float32Array([3, 1, 0]), 2);
+    expect(result.ids).to.be.an.instanceof(Uint32Array);
+    expect(Array.from(result.ids)).to.eql([10, 30]);
+    expect(result.scores[1]).to.be.closeTo(4 / Math.sqrt(20), 1e-6);
+
+    // Two queries give k results each.
+    const both = await index.search(new Float32Array([0, 1, 0, 1, 0, 0]), 1);
+    expect(Array.from(both.ids)).to.eql([20, 10]);
+  });
+
+  it('EmbeddingIndex should replace and remove entries', async () => {
+    const index = new ie.EmbeddingIndex(2, {metric: 'dot'});
+    index.add([1, 2], new Float32Array([1, 0, 0, 1]));
+    index.add(1, new Float32Array([0, 5]));
+    expect(index.size).to.equal(2);
+    expect(Array.from((await index.search(new Float32Array([0, 1]), 1)).scores))
+        .to.eql([5]);
+    expect(index.remove(1)).to.equal(true);
+    expect(index.remove(1)).to.equal(false);
+    expect(Array.from((await index.search(new Float32Array([0, 1]), 5)).ids))
+        .to.eql([2]);
+    index.clear();
+    expect((await index.search(new Float32Array([0, 1]), 5)).ids.length)
+        .to.equal(0);
+  });
+
+  it('EmbeddingIndex should search int8 storage on threads', async () => {
+    const dimension = 64;
+    const index = new ie.EmbeddingIndex(
+        dimension, {storage: 'int8', threads: 4});
+    const count = 10000;
+    const gallery = new Float32Array(count * dimension);
+    for (let i = 0; i < gallery.length; ++i) {
+      gallery[i] = Math.sin(i * 12.9898) * 43758.5453 % 1;
+    }
+    index.add(Array.from({length: count}, (value, i) => i), gallery);
+    const query = gallery.slice(1234 * dimension, 1235 * dimension);
+    const result = await index.search(query, 3);
+    expect(result.ids[0]).to.equal(1234);
+    expect(result.scores[0]).to.be.closeTo(1, 0.01);
+
+    // Several queries split the gallery too, and each one finds itself.
+    const rows = [17, 4321, 9999];
+    const queries = new Float32Array(rows.length * dimension);
+    rows.forEach((row, i) => queries.set(
+        gallery.subarray(row * dimension, (row + 1) * dimension),
+        i * dimension));
+    const batch = await index.search(queries, 3, {threads: 8});
+    expect(batch.ids.length).to.equal(rows.length * 3);
+    rows.forEach((row, i) => expect(batch.ids[i * 3]).to.equal(row));
+  });
+
+  it('EmbeddingIndex should search the gallery as it was', async () => {
+    const index = new ie.EmbeddingIndex(2, {metric: 'dot'});
+    index.add([1, 2], new Float32Array([1, 0, 0, 1]));
+    const searching = index.search(new Float32Array([0, 1]), 2);
+    // Changes made before the search completes go to a copy.
+    index.add(3, new Float32Array([0, 9]));
+    index.remove(2);
+    const result = await searching;
+    expect(Array.from(result.ids)).to.eql([2, 1]);
+    expect(Array.from((await index.search(new Float32Array([0, 1]), 1)).ids))
+        .to.eql([3]);
+    const cleared = index.search(new Float32Array([0, 1]), 1);
+    index.clear();
+    expect((await cleared).ids.length).to.equal(1);
+    expect(index.size).to.equal(0);
+  });
+
+  it('EmbeddingIndex should take embeddings from a Blob', async () => {
+    const core = new ie.Core();
+    const net = await core.readNetwork(
+        './models/squeezenet1.1/FP16/squeezenet1.1.xml',
+        './models/squeezenet1.1/FP16/squeezenet1.1.bin');
+    const exec_net = await core.loadNetwork(net, 'CPU');
+    const infer_req = exec_net.createInferRequest();
+    await infer_req.startAsync();
+    const blob = infer_req.getBlob('prob');
+    const index = new ie.EmbeddingIndex(1000);
+    index.add(7, blob);
+    const result = await index.search(blob, 1);
+    expect(result.ids[0]).to.equal(7);
+    expect(result.scores[0]).to.be.closeTo(1, 1e-5);
+  });
+
+  it('EmbeddingIndex should throw for invalid arguments', async () => {
+    expect(() => new ie.EmbeddingIndex()).to.throw(TypeError);
+    expect(() => new ie.EmbeddingIndex(0)).to.throw(TypeError);
+    expect(() => new ie.EmbeddingIndex(2, {storage: 'int4'}))
+        .to.throw(TypeError);
+    const index = new ie.EmbeddingIndex(2);
+    expect(() => index.add([1, 2], new Float32Array(2))).to.throw(RangeError);
+    expect(() => index.add(1, [1, 2])).to.throw(TypeError);
+    await expect(index.search(new Float32Array(3), 1))
+        .to.be.rejectedWith(RangeError);
+    await expect(index.search(new Float32Array(2)))
+        .to.be.rejectedWith(TypeError);
+    expect(() => index.clear(1)).to.throw(TypeError);
+  });
+});
@@ -0,0 +1,78 @@
+const describe = require('mocha').describe;
+var chai = require('chai');
+var expect = chai.expect;
+
+const ie = require('../lib/inference-engine-node');
+
+const model_path = './models/squeezenet1.1/FP16/squeezenet1.1.xml';
+const weights_path = './models/squeezenet1.1/FP16/squeezenet1.1.bin';
+
+describe('Ensemble Test', function() {
+  let exec_nets;
+  let input;
+  before(async () => {
+    const core = new ie.Core();
+    const net = await core.readNetwork(model_path, weights_path);
+    exec_nets = [
+      await core.loadNetwork(net, 'CPU'), await core.loadNetwork(net, 'CPU')
+    ];
+    input = new Float32Array(3 * 227 * 227);
+    for (let i = 0; i < input.length; ++i) {
+      input[i] = i % 255;
+    }
+  });
+
+  it('Ensemble should run every network on one input', async () => {
+    const ensemble = new ie.Ensemble(exec_nets);
+    const outputs = await ensemble.run({data: input});
+    expect(outputs.length).to.equal(2);
+    expect(outputs[0]['prob']).to.be.an.instanceof(Float32Array);
+    expect(outputs[0]['prob']).to.not.equal(outputs[1]['prob']);
+    expect(Array.from(outputs[0]['prob']))
+        .to.eql(Array.from(outputs[1]['prob']));
+  });
+
+  it('Ensemble should run shadows only on spare capacity', async () => {
+    const results = [];
+    const ensemble = new ie.Ensemble(exec_nets, {
+      shadow: true,
+      onShadowResult: (error, outputs, index) => results.push(index)
+    });
+    const outputs = await Promise.all(
+        [ensemble.run({data: input}), ensemble.run({data: input})]);
+    expect(outputs[0]['prob'].length).to.equal(1000);
+    const stats = ensemble.getStats();
+    expect(stats.runs).to.equal(2);
+    expect(stats.shadowRuns + stats.shadowSkips).to.equal(2);
+    expect(stats.shadowSkips).to.be.at.least(1);
+    while (ensemble.getStats().running[1] > 0) {
+      await new Promise((resolve) => setTimeout(resolve, 10));
+    }
+    expect(results).to.eql([1]);
+  });
+
+  it('Ensemble should give shadows a copy of the inputs', async () => {
+    let resolveShadow;
+    const shadow_outputs = new Promise((resolve) => resolveShadow = resolve);
+    const ensemble = new ie.Ensemble(exec_nets, {
+      shadow: true,
+      onShadowResult: (error, outputs) => resolveShadow(outputs)
+    });
+    const data = input.slice();
+    const outputs = await ensemble.run({data});
+    // The caller may reuse the inputs once run() resolves.
+    data.fill(7);
+    expect(Array.from((await shadow_outputs)['prob']))
+        .to.eql(Array.from(outputs['prob']));
+    // The idle primary request no longer binds them.
+    const request = ensemble.idle[0][0];
+    expect(new Float32Array(request.getBlob('data').rmap())[0])
+        .to.not.equal(7);
+  });
+
+  it('Ensemble should throw for invalid arguments', () => {
+    expect(() => new ie.Ensemble([])).to.throw(TypeError);
+    expect(() => new ie.Ensemble(exec_nets, {maxShadowRequests: 0}))
+        .to.throw(RangeError);
+  });
+});
@@ -261,4 +261,706 @@ describe('ExecutableNetwork Test', function() {
     }
     output_blob.unmap();
   });
-});
\ No newline at end of file
+
+  it('Blob.getTensorDesc should return the desc of the blob', () => {
+    const blob = exec_net.createInferRequest().getBlob('data');
+    expect(blob.getTensorDesc()).to.eql(
+        {precision: 'fp32', layout: 'nchw', dims: [1, 3, 227, 227]});
+  });
+
+  it('InferRequest.setBlob should throw for wrong type of arguments', () => {
+    const infer_req = exec_net.createInferRequest();
+    expect(() => infer_req.setBlob('data', 1)).to.throw(TypeError);
+    expect(() => infer_req.setBlob('data', new Uint8Array(1 * 3 * 227 * 227)))
+        .to.throw(TypeError);
+  });
+
+  it('InferRequest.setBlob should throw for mismatched length', () => {
+    const infer_req = exec_net.createInferRequest();
+    expect(() => infer_req.setBlob('data', new Float32Array(10)))
+        .to.throw(RangeError);
+  });
+
+  it('InferRequest.unbindBlobs should bind the own blobs again', () => {
+    const infer_req = exec_net.createInferRequest();
+    const own_blob = infer_req.getBlob('data');
+    new Float32Array(own_blob.wmap()).fill(1);
+    own_blob.unmap();
+    infer_req.setBlob('data', new Float32Array(3 * 227 * 227).fill(2));
+    expect(new Float32Array(infer_req.getBlob('data').rmap())[0]).to.equal(2);
+    infer_req.unbindBlobs();
+    expect(new Float32Array(infer_req.getBlob('data').rmap())[0]).to.equal(1);
+    infer_req.unbindBlobs();
+    expect(() => infer_req.unbindBlobs(1)).to.throw(TypeError);
+  });
+
+  it('InferRequest.unbindBlobs should undo the resize of setBlob', async () => {
+    const infer_req = exec_net.createInferRequest();
+    const own_blob = infer_req.getBlob('data');
+    new Float32Array(own_blob.wmap()).fill(100);
+    own_blob.unmap();
+    infer_req.setBlob('data', new Uint8Array(1 * 3 * 454 * 454).fill(50), {
+      tensorDesc: {precision: 'u8', layout: 'nhwc', dims: [1, 3, 454, 454]},
+      resizeAlgorithm: 'resize_bilinear'
+    });
+    infer_req.infer();
+    infer_req.unbindBlobs();
+    expect(new Float32Array(infer_req.getBlob('data').rmap())[0])
+        .to.equal(100);
+    infer_req.infer();
+    const prob = new Float32Array(infer_req.getBlob('prob').rmap());
+
+    const outputs = await exec_net.createInferRequest().run(
+        {data: new Float32Array(1 * 3 * 227 * 227).fill(100)});
+    for (let i = 0; i < 1000; i++) {
+      assert(
+          Math.abs(prob[i] - outputs.prob[i]) < 1e-4,
+          `output data equals to the data of the own input`);
+    }
+  });
+
+  it('InferRequest.unbindBlobs should undo the NV12 conversion', async () => {
+    const core = new ie.Core();
+    const net = await core.readNetwork(
+        './models/squeezenet1.1/FP16/squeezenet1.1.xml',
+        './models/squeezenet1.1/FP16/squeezenet1.1.bin');
+    net.getInputsInfo()[0].setPrecision('u8');
+    const u8_exec_net = await core.loadNetwork(net, 'CPU');
+    const infer_req = u8_exec_net.createInferRequest();
+    const own_blob = infer_req.getBlob('data');
+    new Uint8Array(own_blob.wmap()).fill(100);
+    own_blob.unmap();
+    const y = new Uint8Array(228 * 228).fill(128);
+    const uv = new Uint8Array(228 * 228 / 2).fill(128);
+    infer_req.setNV12Blob(
+        'data', y, uv, 228, 228, {resizeAlgorithm: 'resize_bilinear'});
+    infer_req.infer();
+    infer_req.unbindBlobs();
+    expect(new Uint8Array(infer_req.getBlob('data').rmap())[0]).to.equal(100);
+    infer_req.infer();
+    const prob = new Float32Array(infer_req.getBlob('prob').rmap());
+
+    const outputs = await u8_exec_net.createInferRequest().run(
+        {data: new Uint8Array(1 * 3 * 227 * 227).fill(100)});
+    for (let i = 0; i < 1000; i++) {
+      assert(
+          Math.abs(prob[i] - outputs.prob[i]) < 1e-4,
+          `output data equals to the data of the own input`);
+    }
+  });
+
+  it('Check InferRequest.infer result with a SharedArrayBuffer input', () => {
+    const infer_req = exec_net.createInferRequest();
+    const input_data = ie.allocateSharedBlob(infer_req, 'data');
+    expect(input_data.buffer).to.be.instanceof(SharedArrayBuffer);
+    for (let i = 0; i < input_data.length; i++) {
+      input_data[i] = i / (input_data.length + 1);
+    }
+    infer_req.infer();
+    const output_blob = infer_req.getBlob('prob');
+    const output_data = new Float32Array(output_blob.rmap());
+    for (let i = 0; i < output_references.length; i++) {
+      assert(
+          almostEqual(output_data[i], output_references[i]),
+          `output data equals to reference data`);
+    }
+    output_blob.unmap();
+  });
+
+  it('InferRequest.run should reject for invalid arguments', async () => {
+    const infer_req = exec_net.createInferRequest();
+    await expect(infer_req.run()).to.be.rejectedWith(TypeError);
+    await expect(infer_req.run({data: [1, 2]})).to.be.rejectedWith(TypeError);
+    await expect(infer_req.run({data: new Float32Array(10)}))
+        .to.be.rejectedWith(RangeError);
+  });
+
+  it('Check InferRequest.run result', async () => {
+    const infer_req = exec_net.createInferRequest();
+    const input_data = new Float32Array(1 * 3 * 227 * 227);
+    for (let i = 0; i < input_data.length; i++) {
+      input_data[i] = i / (input_data.length + 1);
+    }
+    const prob = new Float32Array(1000);
+    const outputs = await infer_req.run({data: input_data}, {prob: prob});
+    expect(outputs.prob).to.equal(prob);
+    for (let i = 0; i < output_references.length; i++) {
+      assert(
+          almostEqual(prob[i], output_references[i]),
+          `output data equals to reference data`);
+    }
+  });
+
+  it('InferRequest.run should reuse its output TypedArrays', async () => {
+    const infer_req = exec_net.createInferRequest();
+    const input_data = new Float32Array(1 * 3 * 227 * 227);
+    const first = await infer_req.run({data: input_data});
+    const second = await infer_req.run({data: input_data});
+    expect(first.prob).to.be.a('Float32Array');
+    expect(second.prob).to.equal(first.prob);
+  });
+
+  it('InferRequest.attachRingBuffer should feed the newest window', () => {
+    const infer_req = exec_net.createInferRequest();
+    const window = 3 * 227 * 227;
+    const ring = infer_req.attachRingBuffer('data', {hop: 1000});
+    expect([ring.window, ring.hop, ring.ready]).to.eql([window, 1000, false]);
+    const samples = new Float32Array(window - 500).map((_, i) => i);
+    expect(ring.append(samples)).to.equal(false);
+    infer_req.infer();
+    let data = new Float32Array(infer_req.getBlob('data').rmap());
+    expect([data[499], data[500], data[window - 1]]).to.eql([
+      0, 0, window - 501
+    ]);
+    infer_req.getBlob('data').unmap();
+
+    // Wraps around: the window now ends with the 1000 new samples.
+    expect(ring.append(new Float32Array(1000).fill(-1))).to.equal(true);
+    expect(ring.pending).to.equal(1000);
+    infer_req.infer();
+    expect(ring.pending).to.equal(0);
+    data = new Float32Array(infer_req.getBlob('data').rmap());
+    expect([data[0], data[window - 1001], data[window - 1000]]).to.eql([
+      500, window - 501, -1
+    ]);
+    infer_req.getBlob('data').unmap();
+  });
+
+  it('InferRequest.attachRingBuffer should throw for invalid arguments', () => {
+    const infer_req = exec_net.createInferRequest();
+    expect(() => infer_req.attachRingBuffer('data', {hop: 'a'}))
+        .to.throw(TypeError);
+    expect(() => infer_req.attachRingBuffer('data', {hop: 0}))
+        .to.throw(RangeError);
+    expect(() => infer_req.attachRingBuffer('foo')).to.throw(RangeError);
+    const ring = infer_req.attachRingBuffer('data');
+    expect(() => ring.append(new Uint8Array(4))).to.throw(TypeError);
+    infer_req.detachRingBuffer('data');
+  });
+
+  it('InferRequest states should be empty for a stateless model', () => {
+    const infer_req = exec_net.createInferRequest();
+    expect(infer_req.queryState()).to.eql([]);
+    const snapshot = {};
+    expect(infer_req.getStates(snapshot)).to.equal(snapshot);
+    expect(Object.keys(snapshot).length).to.equal(0);
+    infer_req.setStates(snapshot);
+    infer_req.resetStates();
+  });
+
+  it('InferRequest states should throw for invalid arguments', () => {
+    const infer_req = exec_net.createInferRequest();
+    expect(() => infer_req.queryState(1)).to.throw(TypeError);
+    expect(() => infer_req.getStates(1)).to.throw(TypeError);
+    expect(() => infer_req.setStates()).to.throw(TypeError);
+    expect(() => infer_req.setStates({foo: new Float32Array(1)}))
+        .to.throw(RangeError);
+    expect(() => infer_req.resetStates(1)).to.throw(TypeError);
+  });
+
+  it('InferRequest states should accumulate, restore and reset', async () => {
+    const core = new ie.Core();
+    // Adds its input to a ReadValue/Assign state and outputs the sum.
+    const net = await core.readNetwork(
+        './test/data/accumulator.xml', './test/data/accumulator.bin');
+    const state_exec_net = await core.loadNetwork(net, 'CPU');
+    const infer_req = state_exec_net.createInferRequest();
+    const states = infer_req.queryState();
+    expect(states.length).to.equal(1);
+    const name = states[0].name;
+    const input_blob = infer_req.getBlob('input');
+    const output_blob = infer_req.getBlob('sum');
+    const add = (value) => {
+      new Float32Array(input_blob.wmap())[0] = value;
+      input_blob.unmap();
+      infer_req.infer();
+      const sum = new Float32Array(output_blob.rmap())[0];
+      output_blob.unmap();
+      return sum;
+    };
+
+    expect([add(1), add(2)]).to.eql([1, 3]);
+    const snapshot = infer_req.getStates();
+    expect(Array.from(snapshot[name])).to.eql([3]);
+    expect(add(4)).to.equal(7);
+    expect(infer_req.getStates(snapshot)).to.equal(snapshot);
+    expect(Array.from(snapshot[name])).to.eql([7]);
+
+    snapshot[name][0] = 3;
+    infer_req.setStates(snapshot);
+    expect(add(1)).to.equal(4);
+    infer_req.resetStates();
+    expect(Array.from(infer_req.getStates()[name])).to.eql([0]);
+    expect(add(5)).to.equal(5);
+  });
+
+  it('Blob.fillFromImage should write planar BGR with mean and std', () => {
+    const blob = exec_net.createInferRequest().getBlob('data');
+    const rgba = new Uint8ClampedArray(227 * 227 * 4);
+    for (let i = 0; i < 227 * 227; i++) {
+      rgba.set([10, 20, 30, 255], i * 4);
+    }
+    blob.fillFromImage(rgba, 227, 227, {mean: [0, 10, 10], std: [1, 2, 4]});
+    const data = new Float32Array(blob.rmap());
+    const plane = 227 * 227;
+    expect([data[0], data[plane], data[2 * plane]]).to.eql([30, 5, 0]);
+    expect(data[plane - 1]).to.equal(30);
+    blob.unmap();
+  });
+
+  it('Blob.fillFromImage should honor format and channelOrder', () => {
+    const blob = exec_net.createInferRequest().getBlob('data');
+    const rgb = new Uint8Array(227 * 227 * 3).fill(7);
+    rgb[0] = 1;
+    blob.fillFromImage(rgb, 227, 227, {format: 'rgb', channelOrder: 'rgb'});
+    const data = new Float32Array(blob.rmap());
+    expect(data[0]).to.equal(1);
+    expect(data[227 * 227]).to.equal(7);
+    blob.unmap();
+  });
+
+  it('Blob.fillFromImage should letterbox and return the transform', () => {
+    const blob = exec_net.createInferRequest().getBlob('data');
+    const rgba = new Uint8Array(454 * 227 * 4).fill(200);
+    const transform = blob.fillFromImage(
+        rgba, 454, 227, {resize: 'letterbox', padValue: 114});
+    expect(transform).to.include(
+        {scaleX: 0.5, padX: 0, padY: 56, sourceWidth: 454, sourceHeight: 227});
+    const data = new Float32Array(blob.rmap());
+    expect(data[0]).to.equal(114);
+    expect(data[56 * 227]).to.equal(200);
+    expect(data[(56 + 114) * 227]).to.equal(114);
+    blob.unmap();
+
+    const prediction = new ie.postProcessing.ObjectDetectionPrediction(
+        0, 56 / 227, 1, (56 + 114) / 227, 0.9, 1);
+    const [mapped] = ie.postProcessing.mapToSource([prediction], transform);
+    expect([mapped.x1, mapped.x2]).to.eql([0, 454]);
+    assert(almostEqual(mapped.y1, 0) && Math.abs(mapped.y2 - 227) < 1e-3,
+           'the box covers the source image');
+  });
+
+  it('Blob.fillFromImage should return an identity transform', () => {
+    const blob = exec_net.createInferRequest().getBlob('data');
+    const transform =
+        blob.fillFromImage(new Uint8Array(227 * 227 * 4), 227, 227);
+    expect(transform).to.include({scaleX: 1, scaleY: 1, padX: 0, padY: 0});
+  });
+
+  it('Blob.fillFromImage should fill a roi and map it to the image', () => {
+    const blob = exec_net.createInferRequest().getBlob('data');
+    const rgba = new Uint8Array(600 * 300 * 4);
+    for (let i = 0; i < 600 * 300; i++) {
+      rgba[i * 4] = i % 600 < 300 ? 10 : 20;
+    }
+    const transform = blob.fillFromImage(
+        rgba, 600, 300,
+        {roi: {x: 300, y: 50, width: 227, height: 227}, channelOrder: 'rgb'});
+    expect(transform).to.include(
+        {scaleX: 1, padX: -300, padY: -50, sourceWidth: 600});
+    const data = new Float32Array(blob.rmap());
+    expect(data[0]).to.equal(20);
+    blob.unmap();
+  });
+
+  it('Blob.fillFromImage should throw for an invalid roi or batchIndex', () => {
+    const blob = exec_net.createInferRequest().getBlob('data');
+    const rgba = new Uint8Array(227 * 227 * 4);
+    expect(() => blob.fillFromImage(rgba, 227, 227, {roi: {x: 0}}))
+        .to.throw(TypeError);
+    expect(
+        () => blob.fillFromImage(
+            rgba, 227, 227, {roi: {x: 1, y: 0, width: 227, height: 227}}))
+        .to.throw(RangeError);
+    expect(() => blob.fillFromImage(rgba, 227, 227, {batchIndex: 1}))
+        .to.throw(RangeError);
+  });
+
+  it('Blob.fillFromImage should throw for invalid arguments', () => {
+    const blob = exec_net.createInferRequest().getBlob('data');
+    const rgba = new Uint8Array(227 * 227 * 4);
+    expect(() => blob.fillFromImage(rgba, 227)).to.throw(TypeError);
+    expect(() => blob.fillFromImage(new Float32Array(4), 1, 1))
+        .to.throw(TypeError);
+    expect(() => blob.fillFromImage(rgba, 227, 227, {mean: [1]}))
+        .to.throw(TypeError);
+    expect(() => blob.fillFromImage(rgba, 227, 227, {resize: 'crop'}))
+        .to.throw(TypeError);
+    expect(() => blob.fillFromImage(rgba, 227, 227, {layout: 'nhwc'}))
+        .to.throw(TypeError);
+    expect(() => blob.fillFromImage(rgba, 227, 227, {std: [1, 0, 1]}))
+        .to.throw(RangeError);
+    expect(() => blob.fillFromImage(rgba, 227, 227, {std: [1, NaN, 1]}))
+        .to.throw(RangeError);
+    expect(() => blob.fillFromImage(rgba, 227, 227, {mean: [Infinity, 0, 0]}))
+        .to.throw(RangeError);
+    expect(() => blob.fillFromImage(rgba, 227, 227, {padValue: NaN}))
+        .to.throw(RangeError);
+    expect(() => blob.fillFromImage(rgba, 100, 100)).to.throw(RangeError);
+    expect(() => blob.fillFromImage(rgba.subarray(4), 227, 227))
+        .to.throw(RangeError);
+  });
+
+  it('InferRequest.setBlob should throw for invalid options', () => {
+    const infer_req = exec_net.createInferRequest();
+    const data = new Uint8Array(1 * 3 * 454 * 454);
+    expect(() => infer_req.setBlob('data', data, 1)).to.throw(TypeError);
+    expect(() => infer_req.setBlob('data', data, {tensorDesc: {}}))
+        .to.throw(TypeError);
+    expect(() => infer_req.setBlob('data', data, {resizeAlgorithm: 'foo'}))
+        .to.throw(TypeError);
+    expect(() => infer_req.setBlob('data', data, {colorFormat: 'foo'}))
+        .to.throw(TypeError);
+  });
+
+  it('Check InferRequest.infer result with a resized input', async () => {
+    const resized_req = exec_net.createInferRequest();
+    resized_req.setBlob('data', new Uint8Array(1 * 3 * 454 * 454).fill(100), {
+      tensorDesc: {precision: 'u8', layout: 'nhwc', dims: [1, 3, 454, 454]},
+      resizeAlgorithm: 'resize_bilinear'
+    });
+    resized_req.infer();
+    const resized = new Float32Array(resized_req.getBlob('prob').rmap());
+
+    const outputs = await exec_net.createInferRequest().run(
+        {data: new Float32Array(1 * 3 * 227 * 227).fill(100)});
+    for (let i = 0; i < 1000; i++) {
+      assert(
+          Math.abs(resized[i] - outputs.prob[i]) < 1e-4,
+          `output data equals to the data of a network-sized input`);
+    }
+  });
+
+  it('Check InferRequest.infer result with an RGBX ImageData', async () => {
+    const rgbx_req = exec_net.createInferRequest();
+    const pixels = new Uint8ClampedArray(227 * 227 * 4);
+    for (let i = 0; i < 227 * 227; i++) {
+      pixels.set([10, 20, 30, 255], i * 4);
+    }
+    rgbx_req.setBlob('data', pixels, {colorFormat: 'rgbx'});
+    rgbx_req.infer();
+    const rgbx = new Float32Array(rgbx_req.getBlob('prob').rmap());
+
+    const plane = 227 * 227;
+    const bgr = new Float32Array(3 * plane);
+    bgr.fill(30, 0, plane).fill(20, plane, 2 * plane).fill(10, 2 * plane);
+    const outputs = await exec_net.createInferRequest().run({data: bgr});
+    for (let i = 0; i < 1000; i++) {
+      assert(
+          Math.abs(rgbx[i] - outputs.prob[i]) < 1e-4,
+          `output data equals to the data of a BGR input`);
+    }
+    expect(() => rgbx_req.setBlob('data', pixels.subarray(4), {
+      colorFormat: 'bgrx'
+    })).to.throw(RangeError);
+  });
+
+  it('InferRequest.setNV12Blob should throw for invalid arguments', () => {
+    const infer_req = exec_net.createInferRequest();
+    const y = new Uint8Array(228 * 228);
+    const uv = new Uint8Array(228 * 228 / 2);
+    expect(() => infer_req.setNV12Blob('data', y, uv, 228)).to.throw(TypeError);
+    expect(() => infer_req.setNV12Blob('data', y, [], 228, 228))
+        .to.throw(TypeError);
+    expect(() => infer_req.setNV12Blob('data', y, uv, 227, 227))
+        .to.throw(RangeError);
+    expect(() => infer_req.setNV12Blob('data', y, uv.subarray(1), 228, 228))
+        .to.throw(RangeError);
+    expect(() => infer_req.setI420Blob('data', y, uv, uv, 228, 228, 1))
+        .to.throw(TypeError);
+  });
+
+  it('Check InferRequest.infer result with NV12 and I420 inputs', async () => {
+    const core = new ie.Core();
+    const net = await core.readNetwork(
+        './models/squeezenet1.1/FP16/squeezenet1.1.xml',
+        './models/squeezenet1.1/FP16/squeezenet1.1.bin');
+    net.getInputsInfo()[0].setPrecision('u8');
+    const u8_exec_net = await core.loadNetwork(net, 'CPU');
+    const y = new Uint8Array(228 * 228).fill(128);
+    const uv = new Uint8Array(228 * 228 / 2).fill(128);
+    const u = new Uint8Array(228 * 228 / 4).fill(128);
+    const v = new Uint8Array(228 * 228 / 4).fill(128);
+    const options = {resizeAlgorithm: 'resize_bilinear'};
+
+    const nv12_req = u8_exec_net.createInferRequest();
+    nv12_req.setNV12Blob('data', y, uv, 228, 228, options);
+    nv12_req.infer();
+    const i420_req = u8_exec_net.createInferRequest();
+    i420_req.setI420Blob('data', y, u, v, 228, 228, options);
+    i420_req.infer();
+
+    for (const infer_req of [nv12_req, i420_req]) {
+      const prob = new Float32Array(infer_req.getBlob('prob').rmap());
+      const sum = prob.reduce((acc, p) => acc + p, 0);
+      assert(Math.abs(sum - 1) < 1e-3, 'output data is a distribution');
+    }
+  });
+
+  it('decodeImageInto should reject for invalid arguments', async () => {
+    const blob = exec_net.createInferRequest().getBlob('data');
+    await expect(ie.decodeImageInto(blob)).to.be.rejectedWith(TypeError);
+    await expect(ie.decodeImageInto({}, new Uint8Array(4)))
+        .to.be.rejectedWith(TypeError);
+    await expect(ie.decodeImageInto(blob, 'foo')).to.be.rejectedWith(TypeError);
+    const images = [new Uint8Array(4), new Uint8Array(4)];
+    await expect(ie.decodeImageInto(blob, images))
+        .to.be.rejectedWith(RangeError);
+    await expect(ie.decodeImageInto(blob, new Uint8Array(4), {padValue: NaN}))
+        .to.be.rejectedWith(RangeError);
+    await expect(ie.decodeImageInto(blob, new Uint8Array([1, 2, 3, 4])))
+        .to.be.rejectedWith(Error, 'Only JPEG and PNG');
+  });
+
+  it('Check decodeImageInto result', async function() {
+    const jpeg = require('fs').readFileSync(
+        './example/hello_classification_electron/test.jpg');
+    const blob = exec_net.createInferRequest().getBlob('data');
+    try {
+      await ie.decodeImageInto(blob, jpeg, {colorFormat: 'rgb'});
+    } catch (error) {
+      if (/not built in/.test(error.message)) {
+        this.skip();
+      }
+      throw error;
+    }
+    const data = new Float32Array(blob.rmap());
+    expect(data.every((value) => value >= 0 && value <= 255)).to.be.true;
+    expect(data.some((value) => value > 0)).to.be.true;
+    blob.unmap();
+    await expect(ie.decodeImageInto(blob, jpeg, {resize: false}))
+        .to.be.rejectedWith(Error, 'size');
+  });
+
+  it('decodeImageInto should reject images that are too large', async () => {
+    // A PNG and a JPEG whose headers declare 100000x100000 and
+    // 60000x60000 pixels.
+    const images = [
+      'iVBORw0KGgoAAAANSUhEUgABhqAAAYagCAIAAAAnMJyfAAAACUlEQVR4nGMA' +
+          'AAABAAFe/335AAAAAElFTkSuQmCC',
+      '/9j/4AAQSkZJRgABAQAAAQABAAD/2wBDAAEBAQEBAQEBAQEBAQEBAQEBAQEB' +
+          'AQEBAQEBAQEBAQEBAQEBAQEBAQEBAQEBAQEBAQEBAQEBAQEBAQEBAQEBAQH/' +
+          'wAALCOpg6mABAREA/9oACAEBAAA/AP/Z'
+    ].map((data) => Buffer.from(data, 'base64'));
+    const blob = exec_net.createInferRequest().getBlob('data');
+    for (const image of images) {
+      try {
+        await ie.decodeImageInto(blob, image);
+      } catch (error) {
+        if (/not built in/.test(error.message)) {
+          continue;
+        }
+        expect(error).to.be.an.instanceof(RangeError);
+        expect(error.message).to.match(/too large/);
+        continue;
+      }
+      expect.fail('decodeImageInto should reject');
+    }
+  });
+
+  it('decodeImageInto should decode each image into its batch item',
+     async function() {
+       // 4x4 RGB PNGs: (10x, 10y, 200) and (255, xy, 50 + x) at (x, y).
+       const images = [
+         'iVBORw0KGgoAAAANSUhEUgAAAAQAAAAECAIAAAAmkwkpAAAAKUlEQVR42g3H' +
+             'IQEAAAzDsOHh4fqXUll/WJLYuEhMausq/czOTfbB4hA8XfMOYSAa/DAAAAAA' +
+             'SUVORK5CYII=',
+         'iVBORw0KGgoAAAANSUhEUgAAAAQAAAAECAIAAAAmkwkpAAAALklEQVR42iXH' +
+             'wQ0AIAgEwRMMie0I9F/aGsP8RuiiRIVaPyuxwieW7CImnkRx+gEAphNNaPvS' +
+             'NQAAAABJRU5ErkJggg=='
+       ].map((data) => Buffer.from(data, 'base64'));
+       const pixels = [
+         (x, y) => [10 * x, 10 * y, 200], (x, y) => [255, x * y, 50 + x]
+       ];
+       const core = new ie.Core();
+       // A ReLU over a 2x3x4x4 input, which keeps the pixels as they are.
+       const net = await core.readNetwork('./test/data/batch.xml');
+       const batch_exec_net = await core.loadNetwork(net, 'CPU');
+       const blob = batch_exec_net.createInferRequest().getBlob(
+           net.getInputsInfo()[0].name());
+       try {
+         await ie.decodeImageInto(blob, images, {colorFormat: 'rgb'});
+       } catch (error) {
+         if (/not built in/.test(error.message)) {
+           this.skip();
+         }
+         throw error;
+       }
+       const data = new Float32Array(blob.rmap());
+       for (let b = 0; b < 2; ++b) {
+         for (let y = 0; y < 4; ++y) {
+           for (let x = 0; x < 4; ++x) {
+             const pixel = pixels[b](x, y);
+             for (let c = 0; c < 3; ++c) {
+               expect(data[((b * 3 + c) * 4 + y) * 4 + x]).to.equal(pixel[c]);
+             }
+           }
+         }
+       }
+       blob.unmap();
+     });
+
+  it('Blob.dispose should make later calls throw', () => {
+    const blob = exec_net.createInferRequest().getBlob('data');
+    blob.dispose();
+    expect(() => blob.size()).to.throw(Error);
+    expect(() => blob.wmap()).to.throw(Error);
+  });
+
+  it('Blob.dispose should detach the mapped buffers', () => {
+    const blob = exec_net.createInferRequest().getBlob('data');
+    const buffer = blob.wmap();
+    blob.unmap();
+    const view = new Float32Array(blob.rmap());
+    blob.dispose();
+    expect(buffer.byteLength).to.equal(0);
+    expect(view.length).to.equal(0);
+  });
+
+  it('InferRequest.dispose should make later calls throw or reject',
+     async () => {
+       const infer_req = exec_net.createInferRequest();
+       infer_req.dispose();
+       expect(() => infer_req.getBlob('data')).to.throw(Error);
+       expect(() => infer_req.infer()).to.throw(Error);
+       await expect(infer_req.startAsync()).to.be.rejectedWith(Error);
+     });
+
+  it('InferRequest.dispose should let a pending startAsync finish',
+     async () => {
+       const infer_req = exec_net.createInferRequest();
+       const promise = infer_req.startAsync();
+       infer_req.dispose();
+       await expect(promise).to.be.fulfilled;
+     });
+
+  it('InferRequest.dispose should keep the bound inputs of a pending run',
+     async () => {
+       const infer_req = exec_net.createInferRequest();
+       const input_data = new Float32Array(3 * 227 * 227);
+       for (let i = 0; i < input_data.length; i++) {
+         input_data[i] = i / (input_data.length + 1);
+       }
+       infer_req.setBlob('data', input_data);
+       const promise = infer_req.run({});
+       infer_req.dispose();
+       const outputs = await promise;
+       for (let i = 0; i < output_references.length; i++) {
+         assert(
+             almostEqual(outputs.prob[i], output_references[i]),
+             `output data equals to reference data`);
+       }
+       expect(() => infer_req.getBlob('data')).to.throw(Error);
+     });
+
+  describe('Blob arena', function() {
+    let arena_exec_net;
+    before(async () => {
+      const model_path = './models/squeezenet1.1/FP16/squeezenet1.1.xml';
+      const weights_path = './models/squeezenet1.1/FP16/squeezenet1.1.bin';
+      const core = new ie.Core();
+      const net = await core.readNetwork(model_path, weights_path);
+      arena_exec_net = await core.loadNetwork(net, 'CPU');
+      arena_exec_net.enableBlobArena(1);
+    });
+
+    it('ExecutableNetwork.getBlobArenaStats should return null if not enabled',
+       () => {
+         expect(exec_net.getBlobArenaStats()).to.be.a('null');
+       });
+
+    it('ExecutableNetwork.enableBlobArena should throw for invalid argument',
+       () => {
+         expect(() => exec_net.enableBlobArena('foo')).to.throw(TypeError);
+         expect(() => exec_net.enableBlobArena(0)).to.throw(RangeError);
+       });
+
+    it('InferRequest.releaseBlobs should return the lease to the arena', () => {
+      const infer_req = arena_exec_net.createInferRequest();
+      infer_req.getBlob('data');
+      expect(arena_exec_net.getBlobArenaStats().inUse).to.equal(1);
+      infer_req.releaseBlobs();
+      const stats = arena_exec_net.getBlobArenaStats();
+      expect(stats.inUse).to.equal(0);
+      expect(stats.allocated).to.equal(1);
+      expect(stats.peakInUse).to.equal(1);
+      expect(stats.setByteSize)
+          .to.equal(1 * 3 * 227 * 227 * 4 + 1 * 1000 * 1 * 1 * 4);
+    });
+
+    it('InferRequest.getBlob should throw if the arena is exhausted', () => {
+      const first_req = arena_exec_net.createInferRequest();
+      const second_req = arena_exec_net.createInferRequest();
+      first_req.getBlob('data');
+      expect(() => second_req.getBlob('data')).to.throw(RangeError);
+      first_req.releaseBlobs();
+      expect(second_req.getBlob('data')).to.be.a('Blob');
+      second_req.releaseBlobs();
+    });
+
+    it('InferRequest.releaseBlobs should dispose the leased Blobs', () => {
+      const first_req = arena_exec_net.createInferRequest();
+      const leased_blob = first_req.getBlob('data');
+      first_req.releaseBlobs();
+      expect(() => leased_blob.wmap()).to.throw(Error);
+      const second_req = arena_exec_net.createInferRequest();
+      const second_blob = second_req.getBlob('data');
+      expect(second_blob.size()).to.equal(3 * 227 * 227);
+      expect(() => leased_blob.size()).to.throw(Error);
+      second_req.releaseBlobs();
+      expect(() => second_blob.size()).to.throw(Error);
+    });
+
+    it('InferRequest.run should return the lease when it completes',
+       async () => {
+         const input_data = new Float32Array(3 * 227 * 227);
+         const first_req = arena_exec_net.createInferRequest();
+         const second_req = arena_exec_net.createInferRequest();
+         await first_req.run({data: input_data});
+         expect(arena_exec_net.getBlobArenaStats().inUse).to.equal(0);
+         const running = second_req.run({data: input_data});
+         await expect(first_req.run({data: input_data}))
+             .to.be.rejectedWith(RangeError);
+         await running;
+         await second_req.startAsync();
+         const stats = arena_exec_net.getBlobArenaStats();
+         expect(stats.inUse).to.equal(0);
+         expect(stats.allocated).to.equal(1);
+       });
+
+    it('InferRequest.releaseBlobs should detach the mapped leased buffers',
+       () => {
+         const infer_req = arena_exec_net.createInferRequest();
+         const blob = infer_req.getBlob('data');
+         const buffer = blob.wmap();
+         blob.unmap();
+         const view = new Float32Array(blob.rwmap());
+         infer_req.releaseBlobs();
+         expect(buffer.byteLength).to.equal(0);
+         expect(view.length).to.equal(0);
+         view[0] = 1;
+         expect(view[0]).to.be.an('undefined');
+         expect(arena_exec_net.getBlobArenaStats().inUse).to.equal(0);
+       });
+
+    it('Check InferRequest.startAsync result with leased blobs', async () => {
+      const infer_req = arena_exec_net.createInferRequest();
+      const input_blob = infer_req.getBlob('data');
+      const input_data = new Float32Array(input_blob.wmap());
+      for (let i = 0; i < input_blob.size(); i++) {
+        input_data[i] = i / (input_blob.size() + 1);
+      }
+      input_blob.unmap();
+      await infer_req.startAsync();
+      const output_blob = infer_req.getBlob('prob');
+      const output_data = new Float32Array(output_blob.rmap());
+      for (let i = 0; i < output_references.length; i++) {
+        assert(
+            almostEqual(output_data[i], output_references[i]),
+            `output data equals to reference data`);
+      }
+      output_blob.unmap();
+      infer_req.releaseBlobs();
+    });
+  });
+});
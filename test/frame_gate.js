@@ -0,0 +1,88 @@
+const describe = require('mocha').describe;
+var chai = require('chai');
+var chaiAsPromised = require('chai-as-promised');
+chai.use(chaiAsPromised);
+var expect = chai.expect;
+
+const ie = require('../lib/inference-engine-node');
+
+function frame(width, height, value) {
+  return new Uint8Array(width * height * 4).fill(value);
+}
+
+describe('FrameGate Test', function() {
+  it('FrameGate should pass the first frame and skip identical ones', () => {
+    const gate = new ie.FrameGate();
+    expect(gate.check(frame(64, 48, 100), 64, 48)).to.equal(true);
+    expect(gate.check(frame(64, 48, 100), 64, 48)).to.equal(false);
+    expect(gate.check(frame(64, 48, 101), 64, 48)).to.equal(false);
+    expect(gate.check(frame(64, 48, 200), 64, 48)).to.equal(true);
+    expect(gate.getStats()).to.include(
+        {frames: 4, inferred: 2, skipped: 2, skipRate: 0.5});
+  });
+
+  it('FrameGate should compare with the last inferred frame', () => {
+    const gate = new ie.FrameGate({threshold: 0.05});
+    gate.check(frame(64, 48, 100), 64, 48);
+    // Each frame drifts by less than the threshold from the previous one.
+    expect(gate.check(frame(64, 48, 108), 64, 48)).to.equal(false);
+    expect(gate.check(frame(64, 48, 116), 64, 48)).to.equal(true);
+  });
+
+  it('FrameGate should honor maxSkips, metric and reset', () => {
+    const gate = new ie.FrameGate({maxSkips: 1, metric: 'max'});
+    gate.check(frame(64, 48, 0), 64, 48);
+    expect(gate.check(frame(64, 48, 0), 64, 48)).to.equal(false);
+    expect(gate.check(frame(64, 48, 0), 64, 48)).to.equal(true);
+
+    // A small bright patch changes one cell of the grid.
+    const patch = frame(64, 48, 0);
+    for (let y = 0; y < 4; y++) {
+      patch.fill(255, y * 64 * 4, y * 64 * 4 + 16);
+    }
+    expect(gate.check(patch, 64, 48)).to.equal(true);
+
+    gate.reset();
+    expect(gate.check(patch, 64, 48)).to.equal(true);
+    gate.threshold = 1;
+    expect(gate.threshold).to.equal(1);
+    expect(gate.check(frame(64, 48, 255), 64, 48)).to.equal(false);
+  });
+
+  it('FrameGate should throw for invalid arguments', () => {
+    expect(() => new ie.FrameGate({threshold: 'a'})).to.throw(TypeError);
+    expect(() => new ie.FrameGate({metric: 'foo'})).to.throw(TypeError);
+    const gate = new ie.FrameGate();
+    expect(() => gate.check(frame(4, 4, 0), 4)).to.throw(TypeError);
+    expect(() => gate.check(frame(4, 4, 0), 8, 8)).to.throw(RangeError);
+    expect(() => gate.check(frame(4, 4, 0), 4, 4, {format: 'yuv'}))
+        .to.throw(TypeError);
+  });
+
+  it('FrameGate.run should return cached outputs for skipped frames',
+     async () => {
+       const core = new ie.Core();
+       const net = await core.readNetwork(
+           './models/squeezenet1.1/FP16/squeezenet1.1.xml',
+           './models/squeezenet1.1/FP16/squeezenet1.1.bin');
+       const exec_net = await core.loadNetwork(net, 'CPU');
+       const infer_req = exec_net.createInferRequest();
+       const gate = new ie.FrameGate();
+       const first =
+           await gate.run(infer_req, 'data', frame(227, 227, 50), 227, 227);
+       const second =
+           await gate.run(infer_req, 'data', frame(227, 227, 50), 227, 227);
+       expect(second).to.equal(first);
+       expect(first.prob).to.be.a('Float32Array');
+       expect(gate.getStats().skipped).to.equal(1);
+
+       // Another run of the request does not change the cached outputs.
+       const cached = first.prob.slice();
+       const input = new Float32Array(3 * 227 * 227).fill(1);
+       const other = await infer_req.run({data: input});
+       expect(other.prob).to.not.equal(first.prob);
+       const third =
+           await gate.run(infer_req, 'data', frame(227, 227, 50), 227, 227);
+       expect(third.prob).to.deep.equal(cached);
+     });
+});
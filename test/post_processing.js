@@ -0,0 +1,411 @@
+const describe = require('mocha').describe;
+var chai = require('chai');
+var expect = chai.expect;
+
+const ie = require('../lib/inference-engine-node');
+const {detections} = require('./common/detections');
+
+// A [1, anchors * (5 + classes), height, width] RegionYolo output holding
+// |cells|, or with |logits| the raw output the logistic function maps to it.
+// A cell box has |size| times the anchor size.
+function yoloOutput(width, height, anchors, classes, cells, logits = false) {
+  const entries = 5 + classes;
+  const area = width * height;
+  const data = new Float32Array(anchors * entries * area);
+  const activate = (p) => logits ? Math.log(p / (1 - p)) : p;
+  if (logits) {
+    data.fill(-20);
+  }
+  for (const cell of cells) {
+    const plane = (c) =>
+        (cell.anchor * entries + c) * area + cell.row * width + cell.col;
+    data[plane(0)] = activate(cell.offset[0]);
+    data[plane(1)] = activate(cell.offset[1]);
+    data[plane(2)] = Math.log(cell.size[0]);
+    data[plane(3)] = Math.log(cell.size[1]);
+    data[plane(4)] = activate(cell.objectness);
+    cell.classes.forEach((p, k) => data[plane(5 + k)] = activate(p));
+  }
+  return {data, dims: [1, anchors * entries, height, width]};
+}
+
+describe('PostProcessing Test', function() {
+  it('postProcessing should keep the JS helpers', () => {
+    expect(ie.postProcessing.nms).to.be.a('function');
+    expect(ie.postProcessing.mapToSource).to.be.a('function');
+  });
+
+  it('postProcessing.topK should rank the scores', () => {
+    const top = ie.postProcessing.topK(new Float32Array([1, 3, 2, 3]), 3);
+    expect(top.indices).to.be.an.instanceof(Int32Array);
+    expect(Array.from(top.indices)).to.eql([1, 3, 2]);
+    expect(Array.from(top.scores)).to.eql([3, 3, 2]);
+    const probs =
+        ie.postProcessing.topK(new Float32Array([1, 2, 3]), 5, {softmax: true});
+    expect(probs.indices.length).to.equal(3);
+    expect(probs.scores[0]).to.be.closeTo(0.665241, 1e-6);
+    expect(probs.scores[2]).to.be.closeTo(0.090031, 1e-6);
+  });
+
+  it('postProcessing.topK should throw for invalid arguments', () => {
+    expect(() => ie.postProcessing.topK(new Float32Array(4)))
+        .to.throw(TypeError);
+    expect(() => ie.postProcessing.topK([1, 2], 1)).to.throw(TypeError);
+    expect(() => ie.postProcessing.topK(new Float32Array(4), 0))
+        .to.throw(RangeError);
+  });
+
+  it('postProcessing.topK should read the output Blob in place', async () => {
+    const core = new ie.Core();
+    const net = await core.readNetwork(
+        './models/squeezenet1.1/FP16/squeezenet1.1.xml',
+        './models/squeezenet1.1/FP16/squeezenet1.1.bin');
+    const exec_net = await core.loadNetwork(net, 'CPU');
+    const infer_req = exec_net.createInferRequest();
+    await infer_req.startAsync();
+    const blob = infer_req.getBlob('prob');
+    const top = ie.postProcessing.topK(blob, 5);
+    expect(top.indices.length).to.equal(5);
+    const scores = new Float32Array(blob.rmap());
+    expect(top.scores[0]).to.equal(scores[top.indices[0]]);
+    expect(top.scores[0]).to.equal(Math.max(...scores));
+    blob.unmap();
+  });
+
+  it('postProcessing.decodeSSD should filter and suppress per class', () => {
+    const rows = new Float32Array([
+      ...detections([[1, 0.9, 0, 0, 1, 1], [1, 0.8, 0, 0, 1, 1]]),
+      ...detections([[2, 0.7, 0, 0, 1, 1], [1, 0.3, 0, 0, 1, 1]]),
+      ...detections([[1, 0.6, 0, 0, 0.5, 0.5]], 1),
+      -1, 0, 0, 0, 0, 0, 0
+    ]);
+    expect(ie.postProcessing.decodeSSD(rows).length).to.equal(4 * 7);
+    const kept = ie.postProcessing.decodeSSD(rows, {nms: true});
+    expect(Array.from(kept.filter((value, i) => i % 7 < 2)))
+        .to.eql([0, 1, 0, 2, 1, 1]);
+    const capped = ie.postProcessing.decodeSSD(
+        rows, {threshold: 0.1, maxDetections: 1});
+    expect(capped.length).to.equal(2 * 7);
+    const transform = {
+      scaleX: 0.5,
+      scaleY: 0.5,
+      padX: 0,
+      padY: 0,
+      sourceWidth: 600,
+      sourceHeight: 600,
+      inputWidth: 300,
+      inputHeight: 300
+    };
+    const mapped = ie.postProcessing.decodeSSD(
+        rows, {threshold: 0.85, transform: transform});
+    expect(Array.from(mapped.subarray(3))).to.eql([0, 0, 600, 600]);
+    expect(() => ie.postProcessing.decodeSSD(new Float32Array(6)))
+        .to.throw(RangeError);
+  });
+
+  it('postProcessing.decodeSSD should throw for an invalid image id', () => {
+    const box = [1, 0.9, 0.1, 0.1, 0.5, 0.5];
+    for (const imageId of [1e9, NaN, 2]) {
+      const rows = detections([box, box], imageId);
+      expect(() => ie.postProcessing.decodeSSD(rows)).to.throw(RangeError);
+    }
+    const rows = detections([box, box], 1);
+    expect(ie.postProcessing.decodeSSD(rows)[0]).to.equal(1);
+  });
+
+  it('postProcessing.decodeSSD should read the output Blob', async () => {
+    const core = new ie.Core();
+    const net = await core.readNetwork(
+        './models/mobilenetssd/FP16/mobilenetssd.xml',
+        './models/mobilenetssd/FP16/mobilenetssd.bin');
+    const output = net.getOutputsInfo()[0].name();
+    const exec_net = await core.loadNetwork(net, 'CPU');
+    const infer_req = exec_net.createInferRequest();
+    await infer_req.startAsync();
+    const rows = ie.postProcessing.decodeSSD(
+        infer_req.getBlob(output), {threshold: 0, nms: true});
+    expect(rows.length % 7).to.equal(0);
+    for (let i = 7; i < rows.length; i += 7) {
+      expect(rows[i + 2]).to.be.at.most(rows[i - 5]);
+    }
+  });
+
+  it('postProcessing.decodeYolo should check the outputs', async () => {
+    const config = ie.postProcessing.yoloConfigs.yolov3;
+    expect(config.masks.length).to.equal(3);
+    expect(() => ie.postProcessing.decodeYolo([new Float32Array(4)], config))
+        .to.throw(TypeError);
+    expect(() => ie.postProcessing.decodeYolo([], {classes: 80}))
+        .to.throw(TypeError);
+    expect(ie.postProcessing.decodeYolo([], {classes: 1, anchors: [1, 1]}))
+        .to.be.an.instanceof(Float32Array);
+
+    const core = new ie.Core();
+    const net = await core.readNetwork(
+        './models/mobilenetssd/FP16/mobilenetssd.xml',
+        './models/mobilenetssd/FP16/mobilenetssd.bin');
+    const output = net.getOutputsInfo()[0].name();
+    const exec_net = await core.loadNetwork(net, 'CPU');
+    const blob = exec_net.createInferRequest().getBlob(output);
+    // A [1, 1, 100, 7] tensor is not the output of one anchor of 2 classes.
+    expect(
+        () => ie.postProcessing.decodeYolo(
+            [blob], {classes: 2, anchors: [1, 1], masks: [[0]]}))
+        .to.throw(RangeError);
+  });
+
+  it('postProcessing.decodeYolo should decode the cells of every scale', () => {
+    const config = {
+      classes: 2,
+      anchors: [10, 20, 30, 40, 100, 100],
+      masks: [[0, 1], [2]],
+      inputWidth: 100,
+      inputHeight: 100
+    };
+    const outputs = (logits) => [
+      yoloOutput(2, 2, 2, 2, [
+        // Class 0 at 0.9 * 0.8, class 1 below the threshold.
+        {
+          anchor: 0, row: 0, col: 1, offset: [0.5, 0.5], size: [1, 1],
+          objectness: 0.9, classes: [0.8, 0.1]
+        },
+        {
+          anchor: 1, row: 1, col: 0, offset: [0.25, 0.5], size: [2, 1],
+          objectness: 0.8, classes: [0.1, 0.75]
+        }
+      ], logits),
+      // The single cell of the coarse scale overlaps the first box.
+      yoloOutput(1, 1, 1, 2, [{
+        anchor: 0, row: 0, col: 0, offset: [0.75, 0.25], size: [0.1, 0.2],
+        objectness: 0.7, classes: [0.9, 0.05]
+      }], logits)
+    ];
+    const expected = [
+      [0, 0, 0.72, 0.7, 0.15, 0.8, 0.35],
+      [0, 1, 0.6, -0.175, 0.55, 0.425, 0.95],
+      [0, 0, 0.63, 0.7, 0.15, 0.8, 0.35]
+    ];
+    const expectRows = (rows, indices) => {
+      expect(rows.length).to.equal(indices.length * 7);
+      indices.forEach((index, i) => expected[index].forEach((value, j) => {
+        expect(rows[i * 7 + j]).to.be.closeTo(value, 1e-5);
+      }));
+    };
+
+    const decodeYolo = ie.postProcessing.decodeYolo;
+    // The box of the coarse scale is suppressed by the one of the fine scale.
+    expectRows(decodeYolo(outputs(false), config), [0, 1]);
+    expectRows(decodeYolo(outputs(false), {...config, nms: false}), [0, 2, 1]);
+    // Raw outputs are compared on the logit of the threshold.
+    expectRows(decodeYolo(outputs(true), {...config, sigmoid: true}), [0, 1]);
+    expectRows(
+        decodeYolo(outputs(true), {...config, sigmoid: true, threshold: 0.7}),
+        [0]);
+    // The channels of the first scale are two masked anchors.
+    expect(() => decodeYolo(outputs(false), {...config, masks: [[0], [2]]}))
+        .to.throw(RangeError);
+    expect(() => decodeYolo([{data: new Float32Array(3), dims: [2, 2]}], {
+      classes: 1,
+      anchors: [1, 1]
+    })).to.throw(TypeError);
+  });
+
+  it('postProcessing.segmentationMask should label each pixel', async () => {
+    const core = new ie.Core();
+    const net = await core.readNetwork(
+        './models/squeezenet1.1/FP16/squeezenet1.1.xml',
+        './models/squeezenet1.1/FP16/squeezenet1.1.bin');
+    const exec_net = await core.loadNetwork(net, 'CPU');
+    // The BGR planes of the input make 3 classes: red on the left half,
+    // blue on the right half.
+    const blob = exec_net.createInferRequest().getBlob('data');
+    const pixels = new Uint8Array(227 * 227 * 4);
+    const red = [200, 20, 10, 255];
+    const blue = [10, 20, 200, 255];
+    for (let i = 0; i < 227 * 227; ++i) {
+      pixels.set(i % 227 < 113 ? red : blue, i * 4);
+    }
+    blob.fillFromImage(pixels, 227, 227);
+    const mask = ie.postProcessing.segmentationMask(blob);
+    expect(mask.length).to.equal(227 * 227);
+    expect([mask[0], mask[226], mask[227 * 227 - 1]]).to.eql([2, 0, 0]);
+
+    const output = new Uint8Array(454 * 454 + 1).fill(9);
+    for (const resize of ['nearest', 'bilinear']) {
+      const scaled = ie.postProcessing.segmentationMask(
+          blob, {outputSize: {width: 454, height: 454}, resize, output});
+      expect(scaled).to.equal(output);
+      expect([scaled[0], scaled[225], scaled[453], scaled[454 * 454]])
+          .to.eql([2, 2, 0, 9]);
+    }
+    expect(() => ie.postProcessing.segmentationMask(blob, {
+      outputSize: {width: 454, height: 454},
+      output: new Uint8Array(10)
+    })).to.throw(RangeError);
+    expect(() => ie.postProcessing.segmentationMask(new Float32Array(4)))
+        .to.throw(TypeError);
+  });
+
+  it('postProcessing.decodePose should check the skeleton', async () => {
+    const core = new ie.Core();
+    const net = await core.readNetwork(
+        './models/squeezenet1.1/FP16/squeezenet1.1.xml',
+        './models/squeezenet1.1/FP16/squeezenet1.1.bin');
+    const exec_net = await core.loadNetwork(net, 'CPU');
+    // The [1, 3, 227, 227] input stands for 3 heatmaps and 3 field planes.
+    const blob = exec_net.createInferRequest().getBlob('data');
+    blob.fillFromImage(new Uint8Array(227 * 227 * 4).fill(100), 227, 227);
+    // The 18 COCO keypoints do not fit in 3 channels.
+    expect(() => ie.postProcessing.decodePose(blob, blob)).to.throw(RangeError);
+    expect(() => ie.postProcessing.decodePose(blob, blob, {
+      keypoints: 3,
+      limbs: [[0, 1, 0, 3]]
+    })).to.throw(RangeError);
+    expect(() => ie.postProcessing.decodePose(new Float32Array(4), blob))
+        .to.throw(TypeError);
+
+    const poses = ie.postProcessing.decodePose(
+        blob, blob, {keypoints: 3, limbs: [[0, 1, 0, 1], [1, 2, 1, 2]]});
+    expect(poses.keypoints).to.be.an.instanceof(Float32Array);
+    expect(poses.keypoints.length).to.equal(poses.scores.length * 3 * 3);
+    expect(poses.imageIds.length).to.equal(poses.scores.length);
+  });
+
+  it('postProcessing.decodePose should group two skeletons', () => {
+    // Two upright chains of 4 keypoints, at columns 2 and 8 of a 12x10 grid,
+    // with peaks of 0.9 and 0.8 whose neighbours shift them by -1/6 of a cell
+    // along x and +1/6 along y.
+    const width = 12;
+    const height = 10;
+    const area = width * height;
+    const people = [{column: 2, peak: 0.9}, {column: 8, peak: 0.8}];
+    const heatmaps = new Float32Array(4 * area);
+    for (let k = 0; k < 4; ++k) {
+      for (const {column, peak} of people) {
+        const set = (x, y, value) =>
+            heatmaps[k * area + y * width + x] = value * peak / 0.9;
+        const row = 1 + 2 * k;
+        set(column, row, 0.9);
+        set(column - 1, row, 0.7);
+        set(column + 1, row, 0.5);
+        set(column, row - 1, 0.5);
+        set(column, row + 1, 0.7);
+      }
+    }
+    // The limbs 0-1 and 2-3 make two parts of each pose, which the limb 1-2
+    // then merges. Their fields point down the column of each person.
+    const limbs = [[0, 1, 0, 1], [2, 3, 2, 3], [1, 2, 4, 5]];
+    const pafs = new Float32Array(6 * area);
+    for (const [from, , , pafY] of limbs) {
+      for (const {column} of people) {
+        for (let y = 1 + 2 * from; y <= 3 + 2 * from; ++y) {
+          pafs[pafY * area + y * width + column] = 1;
+        }
+      }
+    }
+
+    const poses = ie.postProcessing.decodePose(
+        {data: heatmaps, dims: [1, 4, height, width]},
+        {data: pafs, dims: [1, 6, height, width]}, {keypoints: 4, limbs});
+    expect(Array.from(poses.imageIds)).to.eql([0, 0]);
+    // The keypoint scores and a score of 1 per limb.
+    expect(poses.scores[0]).to.be.closeTo(4 * 0.9 + 3, 1e-5);
+    expect(poses.scores[1]).to.be.closeTo(4 * 0.8 + 3, 1e-5);
+    people.forEach(({column, peak}, i) => {
+      for (let k = 0; k < 4; ++k) {
+        const keypoint = poses.keypoints.subarray((i * 4 + k) * 3);
+        expect(keypoint[0]).to.be.closeTo((column - 1 / 6 + 0.5) / width, 1e-5);
+        expect(keypoint[1])
+            .to.be.closeTo((1 + 2 * k + 1 / 6 + 0.5) / height, 1e-5);
+        expect(keypoint[2]).to.be.closeTo(peak, 1e-5);
+      }
+    });
+
+    const partial = ie.postProcessing.decodePose(
+        {data: heatmaps, dims: [1, 4, height, width]},
+        {data: pafs, dims: [1, 6, height, width]},
+        {keypoints: 4, limbs: limbs.slice(0, 2), minKeypoints: 2});
+    // Without the limb 1-2 the parts stay apart, and the first one misses
+    // the keypoints 2 and 3.
+    expect(partial.scores.length).to.equal(4);
+    expect(Array.from(partial.keypoints.subarray(6, 12)))
+        .to.eql([-1, -1, 0, -1, -1, 0]);
+  });
+
+  it('postProcessing.nms should suppress overlapping boxes', () => {
+    const boxes = detections([
+      [1, 0.8, 1, 1, 11, 11], [1, 0.9, 0, 0, 10, 10], [2, 0.7, 0, 0, 10, 10]
+    ]);
+    const kept = ie.postProcessing.nms(boxes);
+    expect(kept.length).to.equal(14);
+    expect(Array.from(kept.subarray(1, 3))).to.eql([1, 0.8999999761581421]);
+    expect(kept[8]).to.equal(2);
+    expect(ie.postProcessing.nms(boxes, {classAgnostic: true}).length)
+        .to.equal(7);
+  });
+
+  it('postProcessing.nms should throw for invalid arguments', () => {
+    expect(() => ie.postProcessing.nms()).to.throw(TypeError);
+    expect(() => ie.postProcessing.nms([1, 2])).to.throw(TypeError);
+    expect(() => ie.postProcessing.nms(new Float32Array(6)))
+        .to.throw(RangeError);
+    expect(() => ie.postProcessing.nms(new Float32Array(7), {metric: 'foo'}))
+        .to.throw(TypeError);
+  });
+
+  it('postProcessing.mergeTiledDetections should merge across tiles', () => {
+    const transform = (x) => ({
+      scaleX: 1,
+      scaleY: 1,
+      padX: -x,
+      padY: 0,
+      sourceWidth: 500,
+      sourceHeight: 300,
+      inputWidth: 300,
+      inputHeight: 300
+    });
+    // The same object seen at the right border of the first tile and in
+    // the middle of the second one, plus a row past the last tile.
+    const first = detections([[1, 0.6, 0.9, 0.5, 1, 0.6]]);
+    const second = new Float32Array([
+      ...detections([[1, 0.9, 70 / 300, 0.5, 130 / 300, 0.6]]),
+      ...detections([[1, 0.9, 0, 0, 1, 1]], 1),
+      -1, 0, 0, 0, 0, 0, 0
+    ]);
+    const merged = ie.postProcessing.mergeTiledDetections(
+        [first, second], [transform(0), [transform(200)]], {metric: 'ios'});
+    expect(merged.length).to.equal(7);
+    expect(Array.from(merged.subarray(3)).map(Math.round))
+        .to.eql([270, 150, 330, 180]);
+  });
+
+  it('computeTiles should cover the image with overlapping tiles', () => {
+    const tiles = ie.computeTiles(700, 300, 300, 300, 32);
+    expect(tiles.map((tile) => tile.x)).to.eql([0, 200, 400]);
+    expect(tiles[2]).to.include({y: 0, width: 300, height: 300});
+    expect(ie.computeTiles(200, 100, 300, 300))
+        .to.eql([{x: 0, y: 0, width: 200, height: 100}]);
+    expect(() => ie.computeTiles(700, 300, 300, 300, 300))
+        .to.throw(RangeError);
+  });
+
+  it('detectTiled should return detections in image pixels', async () => {
+    const core = new ie.Core();
+    const net = await core.readNetwork(
+        './models/mobilenetssd/FP16/mobilenetssd.xml',
+        './models/mobilenetssd/FP16/mobilenetssd.bin');
+    const input = net.getInputsInfo()[0].name();
+    const output = net.getOutputsInfo()[0].name();
+    const exec_net = await core.loadNetwork(net, 'CPU');
+    const requests = [
+      exec_net.createInferRequest(), exec_net.createInferRequest()
+    ];
+    const predictions = await ie.detectTiled(
+        requests, new Uint8Array(1000 * 600 * 4).fill(128), 1000, 600,
+        {inputName: input, outputName: output, threshold: 0});
+    for (const prediction of predictions) {
+      expect(prediction.maxX).to.be.at.most(1000);
+      expect(prediction.maxY).to.be.at.most(600);
+    }
+  });
+});
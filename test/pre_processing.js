@@ -236,4 +236,52 @@ describe('PreProcessingChannel Test', function() {
       }
     }
   });
-});
\ No newline at end of file
+
+  it('Subtraction of an interleaved mean image from the input', async () => {
+    const net = await core.readNetwork(model_path)
+    const inputInfo = net.getInputsInfo()[0];
+    const preProcessInfo = inputInfo.getPreProcess();
+
+    // 3x3 pixels of 3 channels with means -1, -2 and -3.
+    const meanImage = new Float32Array(3 * 3 * 3);
+    for (let i = 0; i < meanImage.length; i++) {
+      meanImage[i] = -(i % 3 + 1);
+    }
+    preProcessInfo.setMeanImage(meanImage, {layout: 'nhwc'});
+    expect(preProcessInfo.getMeanVariant()).to.equal('mean_image');
+    expect(new Float32Array(preProcessInfo.getPreProcessChannel(2).meanData.data))
+        .to.eql(new Float32Array(9).fill(-3));
+
+    const execNet = await core.loadNetwork(net, 'CPU');
+    const inferReq = execNet.createInferRequest();
+    const outputs = await inferReq.run(
+        {[inputInfo.name()]: new Float32Array(27).fill(0)});
+    const outputData = outputs[net.getOutputsInfo()[0].name()];
+    for (let i = 0; i < outputData.length; i++) {
+      expect(outputData[i]).to.equal(Math.floor(i / 9) + 1);
+    }
+  });
+
+  it('Share a mean image between networks', async () => {
+    const net = await core.readNetwork(model_path)
+    const otherNet = await core.readNetwork(model_path)
+    const preProcessInfo = net.getInputsInfo()[0].getPreProcess();
+    preProcessInfo.setMeanImage(new Uint8Array(27).fill(4), {precision: 'u8'});
+
+    const otherPreProcessInfo = otherNet.getInputsInfo()[0].getPreProcess();
+    otherPreProcessInfo.setMeanImage(preProcessInfo);
+    expect(otherPreProcessInfo.getMeanVariant()).to.equal('mean_image');
+    expect(new Float32Array(otherPreProcessInfo.getPreProcessChannel(0)
+                                .meanData.data))
+        .to.eql(new Float32Array(9).fill(4));
+  });
+
+  it('setMeanImage should throw for mismatched data', async () => {
+    const net = await core.readNetwork(model_path)
+    const preProcessInfo = net.getInputsInfo()[0].getPreProcess();
+    expect(() => preProcessInfo.setMeanImage(new Float32Array(10)))
+        .to.throw(TypeError);
+    expect(() => preProcessInfo.setMeanImage(new Int32Array(27)))
+        .to.throw(TypeError);
+  });
+});
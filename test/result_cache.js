@@ -0,0 +1,56 @@
+const describe = require('mocha').describe;
+var chai = require('chai');
+var chaiAsPromised = require('chai-as-promised');
+chai.use(chaiAsPromised);
+var expect = chai.expect;
+
+const ie = require('../lib/inference-engine-node');
+
+describe('ResultCache Test', function() {
+  let exec_net;
+  before(async () => {
+    const model_path = './models/squeezenet1.1/FP16/squeezenet1.1.xml';
+    const weights_path = './models/squeezenet1.1/FP16/squeezenet1.1.bin';
+    const core = new ie.Core();
+    const net = await core.readNetwork(model_path, weights_path);
+    exec_net = await core.loadNetwork(net, 'CPU');
+  });
+
+  it('hashBytes should return the XXH64 of the bytes', () => {
+    const abc = new Uint8Array([97, 98, 99]);
+    expect(ie.hashBytes(new Uint8Array(0))).to.equal('ef46db3751d8e999');
+    expect(ie.hashBytes(abc)).to.equal('44bc2cf5ad770999');
+    expect(ie.hashBytes([abc.subarray(0, 1), abc.subarray(1)]))
+        .to.equal('44bc2cf5ad770999');
+    expect(ie.hashBytes(abc, 1)).to.not.equal('44bc2cf5ad770999');
+    expect(() => ie.hashBytes('abc')).to.throw(TypeError);
+  });
+
+  it('ResultCache should coalesce identical inputs in flight', async () => {
+    const cache = new ie.ResultCache();
+    const input = new Float32Array(1 * 3 * 227 * 227).fill(1);
+    const [first, second] = await Promise.all([
+      cache.run(exec_net, {data: input}),
+      cache.run(exec_net, {data: input.slice()})
+    ]);
+    expect(second).to.equal(first);
+    expect(first.prob).to.be.a('Float32Array');
+    expect(await cache.run(exec_net, {data: input})).to.equal(first);
+    expect(cache.getStats())
+        .to.include({hits: 1, misses: 1, coalesced: 1, entries: 1});
+  });
+
+  it('ResultCache should evict the least recently used outputs', async () => {
+    // Room for the 1000 probabilities of one input only.
+    const cache = new ie.ResultCache({maxBytes: 4000});
+    const input = (value) =>
+        ({data: new Float32Array(1 * 3 * 227 * 227).fill(value)});
+    const first = await cache.run(exec_net, input(1));
+    await cache.run(exec_net, input(2));
+    expect(await cache.run(exec_net, input(1))).to.not.equal(first);
+    expect(cache.getStats())
+        .to.include({misses: 3, evictions: 2, entries: 1, bytes: 4000});
+    cache.clear();
+    expect(cache.getStats()).to.include({entries: 0, bytes: 0});
+  });
+});
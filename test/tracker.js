@@ -0,0 +1,63 @@
+const describe = require('mocha').describe;
+var chai = require('chai');
+var expect = chai.expect;
+
+const ie = require('../lib/inference-engine-node');
+const {detections} = require('./common/detections');
+
+describe('Tracker Test', function() {
+  it('Tracker should keep the ids of moving objects', () => {
+    const tracker = new ie.Tracker();
+    const first = tracker.update(detections(
+        [[1, 0.9, 10, 10, 50, 90], [2, 0.8, 200, 200, 240, 240]]));
+    expect(first.length).to.equal(14);
+    expect([first[0], first[7]]).to.eql([1, 2]);
+    const second = tracker.update(detections(
+        [[2, 0.7, 201, 200, 241, 240], [1, 0.9, 14, 10, 54, 90]]));
+    expect([second[0], second[1], second[7]]).to.eql([1, 1, 2]);
+    // A box of another label starts a new track.
+    const third = tracker.update(detections([[3, 0.9, 18, 10, 58, 90]]));
+    expect(third[0]).to.equal(3);
+  });
+
+  it('Tracker should predict the frames between detections', () => {
+    const tracker = new ie.Tracker({detectionInterval: 3});
+    expect(tracker.needsDetection).to.equal(true);
+    tracker.update(detections([[1, 0.9, 10, 10, 50, 90]]));
+    expect(tracker.needsDetection).to.equal(false);
+    tracker.predict();
+    tracker.predict();
+    expect(tracker.needsDetection).to.equal(true);
+    tracker.update(detections([[1, 0.9, 22, 10, 62, 90]]));
+    // The object moves 4 pixels per frame.
+    const predicted = tracker.predict();
+    expect(predicted[0]).to.equal(1);
+    expect(predicted[3]).to.be.closeTo(26, 0.5);
+    expect(predicted[5]).to.be.closeTo(66, 0.5);
+  });
+
+  it('Tracker should drop lost tracks and honor minHits', () => {
+    const tracker = new ie.Tracker({maxAge: 1, minHits: 2});
+    const box = detections([[1, 0.9, 10, 10, 50, 90]]);
+    expect(tracker.update(box).length).to.equal(0);
+    expect(tracker.update(box).length).to.equal(7);
+    expect(tracker.update(new Float32Array(0)).length).to.equal(0);
+    tracker.update(new Float32Array(0));
+    // The track is gone, so the object gets a new id.
+    tracker.update(box);
+    expect(tracker.update(box)[0]).to.equal(2);
+    tracker.reset();
+    expect(tracker.needsDetection).to.equal(true);
+    expect(tracker.predict().length).to.equal(0);
+  });
+
+  it('Tracker should throw for invalid arguments', () => {
+    expect(() => new ie.Tracker({detectionInterval: 0})).to.throw(TypeError);
+    expect(() => new ie.Tracker({maxAge: 'a'})).to.throw(TypeError);
+    const tracker = new ie.Tracker();
+    expect(() => tracker.update()).to.throw(TypeError);
+    expect(() => tracker.update([1, 2])).to.throw(TypeError);
+    expect(() => tracker.update(new Float32Array(6))).to.throw(RangeError);
+    expect(() => tracker.predict(1)).to.throw(TypeError);
+  });
+});